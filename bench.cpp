@@ -0,0 +1,585 @@
+/**
+ * @file bench.cpp
+ * @brief Micro-benchmark struktur data dan algoritma RAiVFY
+ *
+ * Dibangun dari sumber yang sama dengan aplikasi:
+ *
+ *   g++ -std=c++17 -O2 -pthread bench.cpp -o bench
+ *   ./bench [--rows 1000,100000,1000000] [--filter sort/]
+ *
+ * Data lagu dibuat secara sintetis (artis & genre berdistribusi Zipf, panjang
+ * judul bervariasi) dengan seed tetap sehingga hasil dapat dibandingkan antar
+ * perubahan. Setiap baris hasil menampilkan waktu dan jumlah alokasi per
+ * operasi.
+ */
+#define RAIVFY_NO_MAIN
+#include "main.cpp"
+
+#include <cctype>
+#include <cmath>
+
+#pragma region Allocation Counter
+namespace {
+std::atomic<size_t> allocation_count{0}; /**< Jumlah pemanggilan new */
+std::atomic<size_t> allocation_bytes{0}; /**< Total byte yang dialokasikan */
+
+void* countedAllocate(size_t size) {
+  allocation_count.fetch_add(1, std::memory_order_relaxed);
+  allocation_bytes.fetch_add(size, std::memory_order_relaxed);
+  if (void* memory = std::malloc(size ? size : 1)) return memory;
+  throw std::bad_alloc();
+}
+}  // namespace
+
+void* operator new(size_t size) { return countedAllocate(size); }
+void* operator new[](size_t size) { return countedAllocate(size); }
+void operator delete(void* memory) noexcept { std::free(memory); }
+void operator delete[](void* memory) noexcept { std::free(memory); }
+void operator delete(void* memory, size_t) noexcept { std::free(memory); }
+void operator delete[](void* memory, size_t) noexcept { std::free(memory); }
+#pragma endregion
+
+#pragma region Song Generator
+/**
+ * @class SongGenerator
+ * @brief Pembuat data lagu sintetis yang menyerupai katalog musik
+ *
+ * Artis dan genre dipilih dengan distribusi Zipf (sedikit artis / genre
+ * populer, banyak yang jarang muncul). Judul terdiri dari 1-7 kata, tahun
+ * rilis terpusat di sekitar 2005, dan jumlah pemutaran berekor panjang.
+ */
+class SongGenerator {
+ public:
+  /**
+   * @param seed Seed generator acak
+   * @param artist_count Jumlah artis berbeda
+   */
+  explicit SongGenerator(uint64_t seed = 42, size_t artist_count = 5000)
+      : random_(seed) {
+    static const char* kFirst[] = {
+        "Luna",  "Echo",   "Nova",   "Velvet", "Silver", "Neon",  "Crimson",
+        "Atlas", "Indigo", "Golden", "Paper",  "Hollow", "Wild",  "Lunar",
+        "Ruby",  "Ocean",  "Static", "Arctic", "Electric", "Quiet", "Broken",
+        "Midnight", "Summer", "Fading", "Scarlet", "Cosmic", "Young", "Iron",
+        "Glass", "Ivory",  "Amber",  "Black",  "Blue",   "Lost",  "Solar"};
+    static const char* kLast[] = {
+        "Rivers",  "Foxes",   "Kids",     "Lights",  "Harbor",  "Pilots",
+        "Tides",   "Monarchs", "Wolves",  "Hearts",  "Parade",  "Society",
+        "Avenue",  "Machine", "Collective", "Brothers", "Sisters", "Bloom",
+        "Theory",  "Canyon",  "Empire",   "Saints",  "Giants",  "Motel",
+        "Season",  "Garden",  "Signal",   "Horizon", "Ghosts",  "Rebels"};
+    static const char* kGenres[] = {
+        "Pop",     "Rock",      "Hip-Hop", "R&B",    "Electronic", "Jazz",
+        "Indie",   "Country",   "Metal",   "Folk",   "Classical",  "Reggae",
+        "K-Pop",   "Dangdut",   "Latin",   "Blues",  "Soul",       "Punk",
+        "Funk",    "Ambient",   "Grunge",  "Disco",  "Gospel",     "Ska",
+        "Pop Ballad"};
+    static const char* kWords[] = {
+        "love",  "night",   "heart",  "dream",  "fire",   "rain",   "light",
+        "dance", "forever", "home",   "baby",   "city",   "summer", "lonely",
+        "gold",  "river",   "wild",   "stars",  "blue",   "shadow", "run",
+        "tonight", "sky",   "young",  "world",  "moon",   "ocean",  "believe",
+        "story", "highway", "alive",  "broken", "memory", "paradise", "thunder",
+        "whisper", "echo",  "midnight", "electric", "together", "sweet",
+        "bitter", "angel",  "diamond", "neon",  "rebel",  "golden", "silence"};
+
+    size_t first_count = sizeof(kFirst) / sizeof(kFirst[0]);
+    size_t last_count = sizeof(kLast) / sizeof(kLast[0]);
+    artists_.reserve(artist_count);
+    for (size_t i = 0; i < artist_count; i++) {
+      std::string name = std::string(kFirst[i % first_count]) + ' ' +
+                         kLast[(i / first_count) % last_count];
+      if (i >= first_count * last_count) {
+        name += ' ' + std::to_string(i / (first_count * last_count));
+      }
+      artists_.push_back(name);
+    }
+
+    genres_.assign(std::begin(kGenres), std::end(kGenres));
+    words_.assign(std::begin(kWords), std::end(kWords));
+
+    artist_rank_ = zipf(artists_.size(), 1.07);
+    genre_rank_ = zipf(genres_.size(), 1.2);
+  }
+
+  /**
+   * @brief Membuat sejumlah lagu dengan ID berurutan mulai dari 1
+   *
+   * @param rows Jumlah lagu
+   * @return ArrayList<Song> Lagu-lagu terurut berdasarkan ID
+   */
+  ArrayList<Song> generate(size_t rows) {
+    ArrayList<Song> songs;
+    songs.reserve(rows);
+    Song::id_counter = 1;
+    for (size_t i = 0; i < rows; i++) songs.add(next());
+    return songs;
+  }
+
+  /**
+   * @brief Membuat satu lagu acak
+   *
+   */
+  Song next() {
+    std::string title = makeTitle();
+    const std::string& artist = artists_[artist_rank_(random_)];
+    const std::string& genre = genres_[genre_rank_(random_)];
+
+    int year = static_cast<int>(std::clamp(year_(random_), 1960.0, 2025.0));
+    size_t duration =
+        static_cast<size_t>(std::clamp(duration_(random_), 60.0, 900.0));
+    size_t play_count = static_cast<size_t>(
+        50.0 * std::pow(1.0 - unit_(random_), -1.3) - 50.0);
+
+    return Song(title.c_str(), artist.c_str(), genre.c_str(), year, duration,
+                play_count);
+  }
+
+  /**
+   * @brief Mengambil artis acak (mengikuti distribusi yang sama)
+   *
+   */
+  const std::string& artist() { return artists_[artist_rank_(random_)]; }
+
+  /**
+   * @brief Mengambil genre acak (mengikuti distribusi yang sama)
+   *
+   */
+  const std::string& genre() { return genres_[genre_rank_(random_)]; }
+
+  /**
+   * @brief Mengambil satu kata judul acak
+   *
+   */
+  const std::string& word() {
+    return words_[std::uniform_int_distribution<size_t>(
+        0, words_.size() - 1)(random_)];
+  }
+
+ private:
+  std::mt19937_64 random_;          /**< Generator acak */
+  std::vector<std::string> artists_; /**< Nama artis, populer di depan */
+  std::vector<std::string> genres_;  /**< Nama genre, populer di depan */
+  std::vector<std::string> words_;   /**< Kosakata judul */
+  std::discrete_distribution<size_t> artist_rank_; /**< Peringkat artis */
+  std::discrete_distribution<size_t> genre_rank_;  /**< Peringkat genre */
+  std::discrete_distribution<int> title_words_{
+      0, 14, 26, 24, 16, 10, 6, 4}; /**< Jumlah kata judul (1-7) */
+  std::normal_distribution<double> year_{2005.0, 12.0};
+  std::normal_distribution<double> duration_{215.0, 50.0};
+  std::uniform_real_distribution<double> unit_{0.0, 1.0};
+
+  /**
+   * @brief Distribusi Zipf dengan bobot 1 / k^s
+   *
+   */
+  static std::discrete_distribution<size_t> zipf(size_t count, double s) {
+    std::vector<double> weights(count);
+    for (size_t k = 0; k < count; k++) {
+      weights[k] = 1.0 / std::pow(static_cast<double>(k + 1), s);
+    }
+    return std::discrete_distribution<size_t>(weights.begin(), weights.end());
+  }
+
+  std::string makeTitle() {
+    int count = title_words_(random_);
+    std::string title;
+    for (int i = 0; i < count; i++) {
+      if (i > 0) title += ' ';
+      size_t start = title.size();
+      title += word();
+      title[start] = static_cast<char>(std::toupper(title[start]));
+    }
+    return title;
+  }
+};
+#pragma endregion
+
+#pragma region Benchmark Runner
+/**
+ * @class BenchmarkRunner
+ * @brief Menjalankan benchmark dan mencetak hasilnya dalam bentuk tabel
+ *
+ * Setiap benchmark terdiri dari persiapan (tidak diukur) dan badan yang
+ * menjalankan sejumlah operasi. Badan dijalankan beberapa kali dan waktu
+ * tercepat yang dilaporkan.
+ */
+class BenchmarkRunner {
+ public:
+  explicit BenchmarkRunner(std::string filter) : filter_(std::move(filter)) {}
+
+  /**
+   * @brief Mencetak judul kolom tabel hasil
+   *
+   */
+  void printHeader() const {
+    std::printf("%-30s %9s %9s %14s %11s %13s\n", "benchmark", "rows", "ops",
+                "ns/op", "allocs/op", "bytes/op");
+  }
+
+  /**
+   * @brief Menjalankan satu benchmark
+   *
+   * @param name Nama benchmark (dipakai juga untuk --filter)
+   * @param rows Ukuran data
+   * @param ops Jumlah operasi yang dilakukan badan dalam satu putaran
+   * @param setup Persiapan sebelum setiap putaran (tidak diukur)
+   * @param body Operasi yang diukur
+   */
+  template <typename Setup, typename Body>
+  void run(const std::string& name, size_t rows, size_t ops, Setup setup,
+           Body body) {
+    if (!filter_.empty() && name.find(filter_) == std::string::npos) return;
+
+    size_t repeats = rows >= 1000000 ? 1 : 3;
+    double best_ns = 0;
+    size_t allocations = 0, bytes = 0;
+
+    for (size_t r = 0; r < repeats; r++) {
+      setup();
+
+      size_t count_before = allocation_count.load();
+      size_t bytes_before = allocation_bytes.load();
+      auto start = std::chrono::steady_clock::now();
+      body();
+      auto elapsed = std::chrono::steady_clock::now() - start;
+
+      double ns = std::chrono::duration<double, std::nano>(elapsed).count();
+      if (r == 0 || ns < best_ns) best_ns = ns;
+      allocations = allocation_count.load() - count_before;
+      bytes = allocation_bytes.load() - bytes_before;
+    }
+
+    double per_op = static_cast<double>(ops ? ops : 1);
+    std::printf("%-30s %9zu %9zu %14.1f %11.2f %13.1f\n", name.c_str(), rows,
+                ops, best_ns / per_op, allocations / per_op, bytes / per_op);
+    std::fflush(stdout);
+  }
+
+  /**
+   * @brief Menjalankan benchmark tanpa persiapan
+   *
+   */
+  template <typename Body>
+  void run(const std::string& name, size_t rows, size_t ops, Body body) {
+    run(name, rows, ops, [] {}, body);
+  }
+
+  /**
+   * @brief Mengecek apakah ada benchmark dengan awalan tertentu yang akan
+   * dijalankan, agar persiapan data besar dapat dilewati
+   *
+   * Grup hanya dilewati jika filter menyebut grup lain. Filter tanpa nama
+   * grup (misalnya "by_title") dapat cocok dengan benchmark di grup mana
+   * pun, sehingga seluruh grup disiapkan dan run() yang menyaring per nama.
+   */
+  bool wants(const std::string& prefix) const {
+    if (filter_.empty() || filter_.find(prefix) != std::string::npos ||
+        prefix.find(filter_) != std::string::npos) {
+      return true;
+    }
+
+    for (const char* group : kGroups) {
+      if (filter_.find(group) != std::string::npos) return false;
+    }
+    return true;
+  }
+
+ private:
+  static constexpr const char* kGroups[] = {
+      "sort/", "search/", "linkedlist/", "file/"}; /**< Awalan grup */
+
+  std::string filter_; /**< Substring nama benchmark yang dijalankan */
+};
+
+/**
+ * @brief Mencegah compiler membuang hasil perhitungan benchmark
+ *
+ */
+template <typename T>
+void keep(const T& value) {
+  asm volatile("" : : "g"(&value) : "memory");
+}
+#pragma endregion
+
+#pragma region Benchmarks
+/**
+ * @brief Benchmark pengurutan dengan setiap comparator SongSorter
+ *
+ */
+void benchmarkSorting(BenchmarkRunner& runner, const ArrayList<Song>& songs,
+                      std::mt19937_64& random) {
+  if (!runner.wants("sort/")) return;
+
+  size_t rows = songs.size();
+  ArrayList<Song> shuffled = songs;
+  std::shuffle(shuffled.arr, shuffled.arr + rows, random);
+
+  ArrayList<Song> work;
+  auto reset = [&] { work = shuffled; };
+
+  runner.run("sort/quick/by_id", rows, 1, reset, [&] {
+    SongSorter::quickSort(work, 0, rows - 1, SongSorter::by_id);
+  });
+  runner.run("sort/quick/by_title", rows, 1, reset, [&] {
+    SongSorter::quickSort(work, 0, rows - 1, SongSorter::by_title);
+  });
+  runner.run("sort/quick/by_release_year", rows, 1, reset, [&] {
+    SongSorter::quickSort(work, 0, rows - 1, SongSorter::by_release_year);
+  });
+  runner.run("sort/quick/by_play_count", rows, 1, reset, [&] {
+    SongSorter::quickSort(work, 0, rows - 1, SongSorter::by_play_count);
+  });
+  runner.run("sort/ensure_sorted_by_id", rows, 1, reset,
+             [&] { SongSorter::ensureSortedByID(work); });
+
+  // Bubble sort O(n^2) hanya dijalankan untuk data kecil
+  if (rows <= 5000) {
+    runner.run("sort/bubble/by_id", rows, 1, reset,
+               [&] { SongSorter::bubbleSort(work, SongSorter::by_id); });
+  }
+
+  SongView view(songs);
+  runner.run("sort/view/by_title", rows, 1, [&] { view.reset(); },
+             [&] { view.sortBy(SongSorter::by_title); });
+}
+
+/**
+ * @brief Benchmark setiap mode pencarian SongSearcher
+ *
+ */
+void benchmarkSearching(BenchmarkRunner& runner, ArrayList<Song>& songs,
+                        SongGenerator& generator, std::mt19937_64& random) {
+  if (!runner.wants("search/")) return;
+
+  size_t rows = songs.size();
+  size_t lookups = 100000;
+  std::vector<size_t> ids(lookups);
+  std::uniform_int_distribution<size_t> pick(1, rows);
+  for (size_t& id : ids) id = pick(random);
+
+  runner.run("search/binary/id", rows, lookups, [&] {
+    size_t found = 0;
+    for (size_t id : ids) found += SongSearcher::binarySearchSorted(id, songs);
+    keep(found);
+  });
+
+  // Setiap operasi menelusuri seluruh database
+  size_t scans = std::max<size_t>(1, std::min<size_t>(100, 2000000 / rows));
+  std::vector<std::string> genres, artists, titles;
+  for (size_t i = 0; i < scans; i++) {
+    genres.push_back(generator.genre());
+    artists.push_back(generator.artist());
+    titles.push_back(songs.arr[pick(random) - 1].title);
+  }
+
+  runner.run("search/linear/genre", rows, scans, [&] {
+    for (const std::string& genre : genres) {
+      keep(SongSearcher::searchByGenre(genre, songs).size());
+    }
+  });
+  runner.run("search/linear/artist", rows, scans, [&] {
+    for (const std::string& artist : artists) {
+      keep(SongSearcher::searchByArtist(artist, songs).size());
+    }
+  });
+  runner.run("search/linear/title", rows, scans, [&] {
+    for (const std::string& title : titles) {
+      keep(SongSearcher::searchByTitle(title, songs).size());
+    }
+  });
+
+  // Rentang 5 tahun / 30 detik, index dibangun sebelum pengukuran
+  SongLibrary library;
+  for (size_t i = 0; i < rows; i++) library.appendUnindexed(songs.arr[i]);
+  library.reindex();
+  library.countRange(SongLibrary::RangeColumn::kYear, 0, 0);
+
+  std::uniform_int_distribution<int> year(1960, 2020), duration(60, 600);
+  std::vector<std::pair<int, int>> ranges(lookups);
+  for (auto& range : ranges) range = {year(random), duration(random)};
+
+  runner.run("search/range/year", rows, scans, [&] {
+    for (size_t i = 0; i < scans; i++) {
+      size_t found = 0;
+      library.scanRange(SongLibrary::RangeColumn::kYear, ranges[i].first,
+                        ranges[i].first + 4, [&found](const Song&) {
+                          found++;
+                          return true;
+                        });
+      keep(found);
+    }
+  });
+  runner.run("search/count/duration", rows, lookups, [&] {
+    for (const auto& range : ranges) {
+      keep(library.countRange(SongLibrary::RangeColumn::kDuration,
+                              range.second, range.second + 30));
+    }
+  });
+
+  // Bitmap artis + rentang tahun vs fused scan (judul + jumlah pemutaran)
+  QueryEngine engine(library);
+  std::vector<SongQuery> indexed(scans), fused(scans);
+  for (size_t i = 0; i < scans; i++) {
+    indexed[i]
+        .where(SongQuery::Field::kArtist, artists[i])
+        .whereRange(SongQuery::Field::kYear, ranges[i].first,
+                    ranges[i].first + 9);
+    fused[i]
+        .where(SongQuery::Field::kTitle, titles[i])
+        .whereRange(SongQuery::Field::kPlays, 0, 1000);
+  }
+  auto count = [](const Song&) { return true; };
+
+  runner.run("search/query/artist+year", rows, scans, [&] {
+    for (const SongQuery& query : indexed) keep(engine.run(query, count));
+  });
+  runner.run("search/query/scan", rows, scans, [&] {
+    for (const SongQuery& query : fused) keep(engine.run(query, count));
+  });
+
+  // Genre (OR / NOT) + dekade, seluruhnya dijawab dari bitmap
+  std::vector<SongQuery> genre_decade(lookups / 10);
+  for (size_t i = 0; i < genre_decade.size(); i++) {
+    genre_decade[i]
+        .whereAny(SongQuery::Field::kGenre, {genres[i % scans],
+                                             genres[(i + 1) % scans]},
+                  i % 4 == 0)
+        .whereRange(SongQuery::Field::kDecade, ranges[i].first,
+                    ranges[i].first + 10);
+  }
+  runner.run("search/count/genre+decade", rows, genre_decade.size(), [&] {
+    for (const SongQuery& query : genre_decade) keep(engine.count(query));
+  });
+  runner.run("search/query/genre+decade", rows, scans, [&] {
+    for (size_t i = 0; i < scans; i++) {
+      keep(engine.run(genre_decade[i], count));
+    }
+  });
+}
+
+/**
+ * @brief Benchmark operasi LinkedList (push, insert, deleteNode, reverse)
+ *
+ */
+void benchmarkLinkedList(BenchmarkRunner& runner, const ArrayList<Song>& songs,
+                         std::mt19937_64& random) {
+  if (!runner.wants("linkedlist/")) return;
+
+  size_t rows = songs.size();
+  LinkedList<Song> list;
+  auto fill = [&] {
+    list.clear();
+    for (size_t i = 0; i < rows; i++) list.push(songs.arr[i]);
+  };
+
+  runner.run("linkedlist/push", rows, rows, [&] { list.releaseMemory(); },
+             [&] {
+               for (size_t i = 0; i < rows; i++) list.push(songs.arr[i]);
+             });
+  runner.run("linkedlist/insert/front", rows, rows,
+             [&] { list.releaseMemory(); },
+             [&] {
+               for (size_t i = 0; i < rows; i++) list.insert(songs.arr[i], 0);
+             });
+
+  // Operasi O(n) per elemen dibatasi agar total pekerjaan tetap wajar
+  size_t linear_ops =
+      std::max<size_t>(1, std::min<size_t>(rows, 100000000 / rows));
+  std::uniform_int_distribution<size_t> pick(0, rows - 1);
+
+  runner.run("linkedlist/insert/middle", rows, linear_ops, fill, [&] {
+    for (size_t i = 0; i < linear_ops; i++) {
+      list.insert(songs.arr[i % rows], static_cast<int>(rows / 2));
+    }
+  });
+
+  std::vector<size_t> victims(linear_ops);
+  for (size_t& victim : victims) victim = pick(random);
+  runner.run("linkedlist/deleteNode", rows, linear_ops, fill, [&] {
+    for (size_t victim : victims) list.deleteNode(songs.arr[victim]);
+  });
+
+  runner.run("linkedlist/reverse", rows, 1, fill, [&] { list.reverse(); });
+  list.releaseMemory();
+}
+
+/**
+ * @brief Benchmark penyimpanan dan pembacaan FileManager
+ *
+ * Versi file menulis ke file sementara di direktori kerja, versi memori
+ * memakai MemoryWriter / MemoryReader.
+ */
+void benchmarkFileManager(BenchmarkRunner& runner,
+                          const ArrayList<Song>& songs) {
+  if (!runner.wants("file/")) return;
+
+  size_t rows = songs.size();
+  const std::string path = "bench_songs.tmp.dat";
+  ArrayList<Song> loaded;
+
+  runner.run("file/save", rows, 1,
+             [&] { FileManager::save(path, songs); });
+  runner.run("file/load", rows, 1, [&] { loaded.clear(); },
+             [&] { FileManager::load(path, loaded); });
+  std::remove(path.c_str());
+
+  MemoryWriter writer;
+  runner.run("file/memory/save", rows, 1, [&] { writer = MemoryWriter(); },
+             [&] { FileManager::save(writer, songs); });
+  runner.run("file/memory/load", rows, 1, [&] { loaded.clear(); }, [&] {
+    MemoryReader reader(writer.buffer());
+    FileManager::load(reader, loaded);
+  });
+}
+#pragma endregion
+
+/**
+ * @brief Mengurai daftar angka yang dipisahkan koma, misalnya "1000,100000"
+ *
+ */
+std::vector<size_t> parseRows(const std::string& text) {
+  std::vector<size_t> rows;
+  std::stringstream stream(text);
+  std::string item;
+  while (std::getline(stream, item, ',')) {
+    size_t value = std::strtoull(item.c_str(), nullptr, 10);
+    if (value > 0) rows.push_back(value);
+  }
+  return rows;
+}
+
+int main(int argc, char* argv[]) {
+  std::vector<size_t> sizes{1000, 100000, 1000000};
+  std::string filter;
+
+  for (int i = 1; i < argc; i++) {
+    std::string arg = argv[i];
+    if (arg == "--rows" && i + 1 < argc) {
+      sizes = parseRows(argv[++i]);
+    } else if (arg == "--filter" && i + 1 < argc) {
+      filter = argv[++i];
+    } else {
+      std::fprintf(stderr,
+                   "Penggunaan: bench [--rows 1000,100000,1000000] "
+                   "[--filter <nama>]\n");
+      return arg == "-h" || arg == "--help" ? 0 : 1;
+    }
+  }
+
+  BenchmarkRunner runner(filter);
+  runner.printHeader();
+
+  for (size_t rows : sizes) {
+    SongGenerator generator;
+    std::mt19937_64 random(rows);
+    ArrayList<Song> songs = generator.generate(rows);
+
+    benchmarkSorting(runner, songs, random);
+    benchmarkSearching(runner, songs, generator, random);
+    benchmarkLinkedList(runner, songs, random);
+    benchmarkFileManager(runner, songs);
+  }
+
+  return 0;
+}
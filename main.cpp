@@ -1,10 +1,48 @@
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <charconv>
 #include <chrono>
+#include <climits>
+#include <cerrno>
+#include <cmath>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
 #include <cstring>
+#include <deque>
+#include <fstream>
 #include <functional>
 #include <iomanip>
 #include <iostream>
+#include <iterator>
+#include <limits>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <queue>
+#include <random>
+#include <sstream>
+#include <streambuf>
 #include <string>
+#include <string_view>
 #include <thread>
+#include <type_traits>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#ifndef __WIN32__
+#include <fcntl.h>
+#include <sys/ioctl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
 
 #pragma region Utility:TextStyling
 /**
@@ -13,52 +51,111 @@
  * National Standards Institute) escape code
  *
  * Kelas ini menyediakan static method untuk memberikan efek visual text serta
- * mengatur posisi kursor di terminal
+ * mengatur posisi kursor di terminal. Escape code disimpan sebagai konstanta
+ * compile-time dan teks terformat tidak disalin, sehingga pemformatan tidak
+ * pernah mengalokasikan memori.
  */
 class Text {
  public:
   static constexpr int kAnsi =
       8; /**< Nilai tetap untuk penggunaan std::setw pada teks terformat */
 
+  static constexpr std::string_view kBold = "\033[1m";      /**< Tebal */
+  static constexpr std::string_view kFaint = "\033[2m";     /**< Redup */
+  static constexpr std::string_view kItalic = "\033[3m";    /**< Miring */
+  static constexpr std::string_view kUnderline = "\033[4m"; /**< Garis bawah */
+  static constexpr std::string_view kReset = "\033[0m"; /**< Kembali normal */
+
+  /**
+   * @struct Styled
+   * @brief Teks beserta escape code gayanya, tanpa menyalin teks
+   *
+   * Hanya menunjuk ke teks asli, jadi harus dipakai selama teks tersebut
+   * masih hidup (misalnya langsung di-stream atau di-append).
+   */
+  struct Styled {
+    std::string_view style; /**< Escape code gaya (kosong = tanpa gaya) */
+    std::string_view text;  /**< Teks yang diformat */
+
+    /**
+     * @brief Menulis teks terformat ke buffer keluaran
+     *
+     * @param out Buffer tujuan
+     */
+    void appendTo(std::string& out) const {
+      out.append(style.data(), style.size());
+      out.append(text.data(), text.size());
+      if (!style.empty()) out.append(kReset.data(), kReset.size());
+    }
+
+    size_t size() const {
+      return style.size() + text.size() + (style.empty() ? 0 : kReset.size());
+    }
+
+    operator std::string() const {
+      std::string out;
+      out.reserve(size());
+      appendTo(out);
+      return out;
+    }
+
+    friend std::ostream& operator<<(std::ostream& out, const Styled& styled) {
+      out << styled.style << styled.text;
+      if (!styled.style.empty()) out << kReset;
+      return out;
+    }
+
+    friend std::string operator+(std::string lhs, const Styled& rhs) {
+      lhs.reserve(lhs.size() + rhs.size());
+      rhs.appendTo(lhs);
+      return lhs;
+    }
+
+    friend std::string operator+(const Styled& lhs, std::string_view rhs) {
+      std::string out;
+      out.reserve(lhs.size() + rhs.size());
+      lhs.appendTo(out);
+      out.append(rhs.data(), rhs.size());
+      return out;
+    }
+  };
+
   /**
    * @brief Memberikan efek bold pada teks
    *
    * @param text teks yang ingin diformat
-   * @return std::string dengan format ANSI bold
+   * @return Styled teks dengan format ANSI bold
    */
-  static std::string bold(std::string text) {
-    return "\033[1m" + std::string(text) + "\033[0m";
-  }
+  static constexpr Styled bold(std::string_view text) { return {kBold, text}; }
 
   /**
    * @brief Memberikan efek redup / faint pada teks
    *
    * @param text Teks yang ingin diformat
-   * @return std::string dengan dengan format ANSI faint
+   * @return Styled teks dengan format ANSI faint
    */
-  static std::string faintOff(std::string text) {
-    return "\033[2m" + std::string(text) + "\033[0m";
-    ;
+  static constexpr Styled faintOff(std::string_view text) {
+    return {kFaint, text};
   }
 
   /**
    * @brief Memberikan efek italic pada teks
    *
    * @param text Teks yang ingin diformat
-   * @return std::string dengan format ANSI italic
+   * @return Styled teks dengan format ANSI italic
    */
-  static std::string italic(std::string text) {
-    return "\033[2m" + std::string(text) + "\033[0m";
+  static constexpr Styled italic(std::string_view text) {
+    return {kItalic, text};
   }
 
   /**
    * @brief Memberikan efek underline pada teks
    *
    * @param text Teks yang ingin diformat
-   * @return std::string dengan format ANSI underline
+   * @return Styled teks dengan format ANSI underline
    */
-  static std::string underline(std::string text) {
-    return "\033[4m" + std::string(text) + "\033[0m";
+  static constexpr Styled underline(std::string_view text) {
+    return {kUnderline, text};
   }
 
   /**
@@ -73,1217 +170,9311 @@ class Text {
 };
 #pragma endregion
 
-#pragma region StrukturData
-#pragma region Custom Vector-Like
+#pragma region Utility:Instrumentation
 /**
- * @brief Array class
+ * @class Metrics
+ * @brief Instrumentasi ringan untuk jalur yang sering dipanggil
  *
+ * Timer berbasis scope mencatat durasi ke histogram log-linear milik thread
+ * yang sedang berjalan. Hanya thread pemilik yang menulis ke histogramnya
+ * (tanpa lock), thread lain dapat membaca kapan saja dan hasil seluruh thread
+ * digabung saat dibaca. Counter mencatat alokasi ArrayList / NodePool, byte
+ * yang dibaca / ditulis ke file, serta hit / miss cache lagu.
  *
+ * Instrumentasi hanya aktif jika dikompilasi dengan -DRAIVFY_METRICS, tanpa
+ * flag tersebut RAIVFY_TIMED dan RAIVFY_COUNT tidak menghasilkan kode.
  */
-template <typename T>
-class ArrayList {
+class Metrics {
  public:
-  T arr[1000]{};
-
-  ArrayList() { size_ = 0; }
-  size_t size() { return size_; }
-  bool empty() { return size_ == 0; }
-
-  void add(T& new_data) {
-    if (size_ < 1000) {
-      arr[size_] = new_data;
-      ++size_;
-    }
-  }
-
-  void clear() {
-    for (size_t i = 0; i < size_; i++) {
-      arr[i] = T();
-    }
-    size_ = 0;
-  }
-
-  void decreaseSize() {
-    arr[size_ - 1] = T();
-    size_--;
-  }
-
- private:
-  size_t size_{0};
-};
-#pragma endregion
-#pragma region LinkedList Ganda
-/**
- * @class Node
- * @brief Struktur Node untuk Implementasi Linked List Ganda.
- *
- * @tparam T Tipe data yang akan disimpan dalam node
- */
-template <typename T>
-struct Node {
-  T data;            /**< Data yang akan disimpan dalam node */
-  Node<T>* next;     /**< Pointer ke node selanjutnya */
-  Node<T>* previous; /**< Pointer ke node sebelumnya */
-
-  Node() = default;
-
-  /**
-   * @brief Constructor Node baru dengan data
-   *
-   * @param data Nilai awal yang akan disimpan dalam node
-   *
-   * Pointer node sebelumnya dan selanjutnya akan otomatis memiliki nilai
-   * nullptr
-   */
-  Node(const T& data) : data(data), next(nullptr), previous(nullptr) {}
-};
+#ifdef RAIVFY_METRICS
+  static constexpr bool kEnabled = true;
+#else
+  static constexpr bool kEnabled = false;
+#endif
 
-/**
- * @class LinkedList
- * @brief Implementasi Linked List Ganda
- *
- * @tparam T Tipe data yang akan disimpan dalam list
- */
-template <typename T>
-class LinkedList {
- public:
   /**
-   * @brief Constructor default untuk membuat Linked List Ganda
+   * @brief Jalur kode yang diukur durasinya
    *
-   * Pointer awal dan akhir (head and tail) akan otomatis memiliki nilai nullptr
-   * artinya Linked List dalam kondisi kosong
    */
-  LinkedList() : head_(nullptr), tail_(nullptr), node_counter_(0) {}
+  enum Probe { kSort, kSearch, kLoad, kSave, kRender, kProbeCount };
 
   /**
-   * @brief Mengambil jumlah node dalam linked list
+   * @brief Besaran yang dijumlahkan
    *
-   * @return const int jumlah node saat ini
    */
-  int count() { return node_counter_; }
+  enum Counter {
+    kAllocations,
+    kAllocatedBytes,
+    kBytesRead,
+    kBytesWritten,
+    kCacheHits,
+    kCacheMisses,
+    kCounterCount
+  };
 
   /**
-   * @brief Mengambil pointer ke node kepala atau awal
+   * @brief Ringkasan durasi satu probe dari seluruh thread
    *
-   * @return Node<T>* Pointer ke kepala / awal
    */
-  Node<T>* head() const { return head_; }
+  struct Summary {
+    uint64_t count{0};    /**< Jumlah pemanggilan */
+    uint64_t total_ns{0}; /**< Total durasi */
+    uint64_t max_ns{0};   /**< Durasi terlama */
+    uint64_t p50_ns{0};   /**< Median */
+    uint64_t p90_ns{0};   /**< Persentil 90 */
+    uint64_t p99_ns{0};   /**< Persentil 99 */
+
+    uint64_t meanNs() const { return count ? total_ns / count : 0; }
+  };
 
   /**
-   * @brief Mengambil pointer ke node ekor atau akhir
+   * @brief Hasil pengumpulan seluruh probe dan counter
    *
-   * @return Node<T>* Pointer ke ekor / akhir
    */
-  Node<T>* tail() const { return tail_; }
+  struct Report {
+    Summary probes[kProbeCount];           /**< Ringkasan per probe */
+    uint64_t counters[kCounterCount]{};    /**< Nilai setiap counter */
+    size_t threads{0};                     /**< Jumlah blok thread */
+  };
 
+ private:
   /**
-   * @brief Menambahkan elemen ke bagian belakang list
+   * @class Histogram
+   * @brief Histogram durasi log-linear (gaya HDR)
    *
-   * @param data Nilai yang akan ditambahkan
+   * Nilai < 32 ns disimpan tepat, di atasnya setiap pangkat dua dibagi 16
+   * bucket sehingga galat relatif maksimal sekitar 6%. Hanya satu thread yang
+   * menulis, sehingga penambahan cukup load + store atomik tanpa lock.
    */
-  void push(const T& data) {
-    Node<T>* new_node = new Node<T>(data);
-    if (isEmpty()) {
-      node_counter_++;
-      head_ = tail_ = new_node;
-      return;
+  class Histogram {
+   public:
+    static constexpr size_t kSubBits = 4; /**< Bit presisi per pangkat dua */
+    static constexpr size_t kSub = size_t{1} << kSubBits;
+    static constexpr size_t kBuckets = 2 * kSub + (63 - kSubBits) * kSub;
+
+    void record(uint64_t ns) {
+      bump(buckets_[bucketOf(ns)], 1);
+      bump(total_, ns);
+      if (ns > max_.load(std::memory_order_relaxed)) {
+        max_.store(ns, std::memory_order_relaxed);
+      }
     }
 
-    tail_->next = new_node;
-    new_node->previous = tail_;
-    tail_ = new_node;
-
-    node_counter_++;
-  }
+    /**
+     * @brief Menambahkan isi histogram ke array bucket gabungan
+     *
+     */
+    void mergeInto(std::vector<uint64_t>& buckets, Summary& summary) const {
+      for (size_t i = 0; i < kBuckets; i++) {
+        uint64_t count = buckets_[i].load(std::memory_order_relaxed);
+        buckets[i] += count;
+        summary.count += count;
+      }
+      summary.total_ns += total_.load(std::memory_order_relaxed);
+      summary.max_ns =
+          std::max(summary.max_ns, max_.load(std::memory_order_relaxed));
+    }
 
-  /**
-   * @brief Menambahkan elemen ke bagian depan atau tengah list
-   *
-   * @param data Nilai yang akan ditambahkan
-   * @param position Urutan dimana node akan ditambahkan (0 = depan)
-   */
-  void insert(const T& data, int position = 0) {
-    Node<T>* new_node = new Node<T>(data);
-    node_counter_++;
+    static size_t bucketOf(uint64_t value) {
+      if (value < 2 * kSub) return static_cast<size_t>(value);
 
-    if (isEmpty()) {
-      head_ = tail_ = new_node;
-      return;
+      size_t exponent = 63 - static_cast<size_t>(__builtin_clzll(value));
+      return 2 * kSub + (exponent - kSubBits - 1) * kSub +
+             static_cast<size_t>((value >> (exponent - kSubBits)) & (kSub - 1));
     }
 
-    if (position <= 0) {
-      new_node->next = head_;
-      head_->previous = new_node;
+    /**
+     * @brief Nilai terbesar yang masuk ke bucket tertentu
+     *
+     */
+    static uint64_t upperBound(size_t bucket) {
+      if (bucket < 2 * kSub) return bucket;
 
-      head_ = new_node;
-      return;
+      size_t exponent = (bucket - 2 * kSub) / kSub + kSubBits + 1;
+      uint64_t sub = (bucket - 2 * kSub) % kSub;
+      return ((kSub + sub + 1) << (exponent - kSubBits)) - 1;
     }
 
-    Node<T>* iterator = head_;
+   private:
+    std::atomic<uint64_t> buckets_[kBuckets]{}; /**< Jumlah per bucket */
+    std::atomic<uint64_t> total_{0};            /**< Total durasi */
+    std::atomic<uint64_t> max_{0};              /**< Durasi terlama */
+  };
 
-    for (size_t i = 0; i < position - 1 && isNotNull(iterator); i++) {
-      iterator = iterator->next;
+  /**
+   * @brief Blok metrik milik satu thread
+   *
+   */
+  struct ThreadMetrics {
+    Histogram histograms[kProbeCount];             /**< Durasi per probe */
+    std::atomic<uint64_t> counters[kCounterCount]{}; /**< Nilai counter */
+    unsigned active{0}; /**< Probe yang sedang diukur (bitmask) */
+  };
+
+  /**
+   * @brief Pemegang blok metrik thread, blok dikembalikan saat thread selesai
+   *
+   * Blok tidak pernah dihapus agar hasilnya tetap terhitung, tetapi dipakai
+   * ulang oleh thread berikutnya sehingga jumlah blok tidak melebihi jumlah
+   * thread yang berjalan bersamaan.
+   */
+  struct Lease {
+    ThreadMetrics* metrics;
+
+    Lease() {
+      std::lock_guard<std::mutex> lock(registry_mutex_);
+      if (!free_.empty()) {
+        metrics = free_.back();
+        free_.pop_back();
+      } else {
+        registry_.push_back(std::make_unique<ThreadMetrics>());
+        metrics = registry_.back().get();
+      }
     }
 
-    if (isNull(iterator)) {
-      push(data);
-      delete new_node;
-      return;
+    ~Lease() {
+      std::lock_guard<std::mutex> lock(registry_mutex_);
+      metrics->active = 0;
+      free_.push_back(metrics);
     }
+  };
 
-    new_node->next = iterator->next;
-    new_node->previous = iterator;
+  static inline std::mutex registry_mutex_; /**< Pelindung daftar blok */
+  static inline std::vector<std::unique_ptr<ThreadMetrics>>
+      registry_;                                 /**< Seluruh blok metrik */
+  static inline std::vector<ThreadMetrics*> free_; /**< Blok tanpa thread */
 
-    if (isNotNull(new_node->next)) {
-      new_node->next->previous = new_node;
-    } else {
-      tail_ = new_node;
-    }
+  static ThreadMetrics& local() {
+    thread_local Lease lease;
+    return *lease.metrics;
+  }
 
-    iterator->next = new_node;
+  static void bump(std::atomic<uint64_t>& value, uint64_t amount) {
+    value.store(value.load(std::memory_order_relaxed) + amount,
+                std::memory_order_relaxed);
   }
 
+ public:
   /**
-   * @brief Menghapus node berdasarkan isi data
+   * @class ScopedTimer
+   * @brief Mengukur durasi scope dan mencatatnya ke histogram probe
    *
-   * @param data data yang akan dihapus
+   * Pemanggilan bersarang untuk probe yang sama (misalnya rekursi quickSort)
+   * hanya dicatat oleh scope terluar.
    */
-  void deleteNode(const T& data) {
-    if (isEmpty()) return;
-
-    Node<T>* target_node = head_;
-    while (isNotNull(target_node) && target_node->data != data) {
-      target_node = target_node->next;
+  class ScopedTimer {
+   public:
+    explicit ScopedTimer(Probe probe) : probe_(probe) {
+      ThreadMetrics& metrics = local();
+      if (metrics.active & (1u << probe)) return;
+
+      metrics.active |= 1u << probe;
+      owner_ = &metrics;
+      start_ = std::chrono::steady_clock::now();
     }
 
-    if (isNull(target_node)) return;
+    ScopedTimer(const ScopedTimer&) = delete;
+    ScopedTimer& operator=(const ScopedTimer&) = delete;
 
-    if (isNotNull(target_node->previous)) {
-      target_node->previous->next = target_node->next;
-    } else {
-      head_ = target_node->next;
-    }
+    ~ScopedTimer() {
+      if (!owner_) return;
 
-    if (target_node->next) {
-      target_node->next->previous = target_node->previous;
-    } else {
-      tail_ = target_node->previous;
+      auto elapsed = std::chrono::steady_clock::now() - start_;
+      owner_->active &= ~(1u << probe_);
+      owner_->histograms[probe_].record(static_cast<uint64_t>(
+          std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed)
+              .count()));
     }
 
-    delete target_node;
+   private:
+    Probe probe_;                   /**< Probe yang diukur */
+    ThreadMetrics* owner_{nullptr}; /**< Blok tujuan, null jika bersarang */
+    std::chrono::steady_clock::time_point start_; /**< Waktu mulai */
+  };
 
-    node_counter_--;
+  /**
+   * @brief Menambahkan nilai counter milik thread saat ini
+   *
+   */
+  static void add(Counter counter, uint64_t amount) {
+    bump(local().counters[counter], amount);
   }
 
   /**
-   * @brief Membalik urutan elemen dalam Linked List
+   * @brief Menggabungkan metrik seluruh thread
    *
+   * @return Report Ringkasan durasi setiap probe dan nilai counter
    */
-  void reverse() {
-    if (isEmpty()) return;
-
-    Node<T>* previous_node = nullptr;
-    Node<T>* current_node = head_;
-    Node<T>* next_node = nullptr;
-
-    tail_ = head_;
-
-    while (isNotNull(current_node)) {
-      next_node = current_node->next;
-      current_node->next = previous_node;
-      current_node->previous = next_node;
+  static Report collect() {
+    Report report;
+    std::lock_guard<std::mutex> lock(registry_mutex_);
+    report.threads = registry_.size();
+
+    for (size_t probe = 0; probe < kProbeCount; probe++) {
+      Summary& summary = report.probes[probe];
+      std::vector<uint64_t> buckets(Histogram::kBuckets, 0);
+      for (const auto& metrics : registry_) {
+        metrics->histograms[probe].mergeInto(buckets, summary);
+      }
 
-      previous_node = current_node;
-      current_node = next_node;
+      summary.p50_ns = percentile(buckets, summary, 0.50);
+      summary.p90_ns = percentile(buckets, summary, 0.90);
+      summary.p99_ns = percentile(buckets, summary, 0.99);
     }
 
-    head_ = previous_node;
+    for (const auto& metrics : registry_) {
+      for (size_t counter = 0; counter < kCounterCount; counter++) {
+        report.counters[counter] +=
+            metrics->counters[counter].load(std::memory_order_relaxed);
+      }
+    }
+    return report;
   }
 
   /**
-   * @brief Menghapus seluruh elemen dari linked list
+   * @brief Menulis hasil collect() dalam format JSON
    *
    */
-  void clear() {
-    Node<T>* current{head_};
-
-    while (isNotNull(current)) {
-      Node<T>* next_node = current->next;
-      delete current;
-      current = next_node;
+  static void writeJson(std::ostream& out) {
+    Report report = collect();
+    out << "{\n  \"enabled\": " << (kEnabled ? "true" : "false")
+        << ",\n  \"threads\": " << report.threads << ",\n  \"probes\": {";
+    for (size_t probe = 0; probe < kProbeCount; probe++) {
+      const Summary& summary = report.probes[probe];
+      out << (probe ? ",\n" : "\n") << "    \""
+          << probeName(static_cast<Probe>(probe)) << "\": {\"count\": "
+          << summary.count << ", \"mean_ns\": " << summary.meanNs()
+          << ", \"p50_ns\": " << summary.p50_ns
+          << ", \"p90_ns\": " << summary.p90_ns
+          << ", \"p99_ns\": " << summary.p99_ns
+          << ", \"max_ns\": " << summary.max_ns << "}";
+    }
+    out << "\n  },\n  \"counters\": {";
+    for (size_t counter = 0; counter < kCounterCount; counter++) {
+      out << (counter ? ",\n" : "\n") << "    \""
+          << counterName(static_cast<Counter>(counter))
+          << "\": " << report.counters[counter];
     }
+    out << "\n  }\n}\n";
+  }
 
-    head_ = tail_ = nullptr;
-    node_counter_ = 0;
+  static const char* probeName(Probe probe) {
+    static const char* kNames[] = {"sort", "search", "load", "save", "render"};
+    return kNames[probe];
+  }
+
+  static const char* counterName(Counter counter) {
+    static const char* kNames[] = {"allocations", "allocated_bytes",
+                                   "bytes_read", "bytes_written",
+                                   "cache_hits", "cache_misses"};
+    return kNames[counter];
   }
 
   /**
-   * @brief Mengecek apakah linked list kosong
+   * @brief Memformat durasi dengan satuan yang sesuai (ns, us, ms, s)
    *
-   * @return false jika linked list memiliki node / elemen
-   * @return true jika linked list kosong
    */
-  bool isEmpty() { return !head_; }
+  static std::string formatDuration(uint64_t ns) {
+    char text[32];
+    if (ns < 1000) {
+      std::snprintf(text, sizeof(text), "%llu ns",
+                    static_cast<unsigned long long>(ns));
+    } else if (ns < 1000000) {
+      std::snprintf(text, sizeof(text), "%.1f us", ns / 1e3);
+    } else if (ns < 1000000000) {
+      std::snprintf(text, sizeof(text), "%.2f ms", ns / 1e6);
+    } else {
+      std::snprintf(text, sizeof(text), "%.2f s", ns / 1e9);
+    }
+    return text;
+  }
 
  private:
-  Node<T>* head_;       /**< Pointer ke elemen kepala / awal */
-  Node<T>* tail_;       /**< Pointer ke elemen ekor / akhir */
-  size_t node_counter_; /**< Jumlah elemen dallam list */
-
-  /**
-   * @brief Mengecek apakah node kosong
-   *
-   * @param node Pointer node yang ingin dicek
-   * @return true jika elemen kosong
-   * @return false jika elemen memiliki nilai / isi
-   */
-  bool isNull(Node<T>* node) { return !node; }
-  bool isNotNull(Node<T>* node) { return node; }
+  static uint64_t percentile(const std::vector<uint64_t>& buckets,
+                             const Summary& summary, double quantile) {
+    if (summary.count == 0) return 0;
+
+    // Peringkat terdekat ke atas: ceil(quantile * count), minimal 1
+    double rank = quantile * static_cast<double>(summary.count);
+    uint64_t target = static_cast<uint64_t>(rank);
+    if (target < rank || target == 0) target++;
+
+    uint64_t seen = 0;
+    for (size_t i = 0; i < buckets.size(); i++) {
+      seen += buckets[i];
+      if (seen >= target) {
+        return std::min(Histogram::upperBound(i), summary.max_ns);
+      }
+    }
+    return summary.max_ns;
+  }
 };
+
+#ifdef RAIVFY_METRICS
+#define RAIVFY_TIMED(probe) \
+  Metrics::ScopedTimer metrics_timer { Metrics::probe }
+#define RAIVFY_COUNT(counter, amount) Metrics::add(Metrics::counter, amount)
+#else
+#define RAIVFY_TIMED(probe) static_cast<void>(0)
+#define RAIVFY_COUNT(counter, amount) static_cast<void>(0)
+#endif
 #pragma endregion
 
-#pragma region FileHandling
+#pragma region Utility:Rendering
 /**
- * @class FileManager
- * @brief Kelas berisi static method untuk melakukan operasi penyimpanan dan
- * pembacaan data dari file
+ * @class Frame
+ * @brief Satu tampilan terminal yang disusun di memori sebelum ditulis
  *
- * Penyimpanan dan pembacaan secara keseluruhan dilakukan untuk binary file
+ * Seluruh baris disimpan berurutan di satu buffer (tanpa karakter newline)
+ * beserta batas akhir tiap baris, sehingga satu frame cukup satu alokasi
+ * jika ukurannya diperkirakan di awal.
  */
-class FileManager {
+class Frame {
  public:
-  static constexpr const char* kDatabase{
-      "DatabaseLagu.dat"}; /**< Nama file default untuk database lagu */
-  static constexpr const char* kPlaylist{
-      "DatabasePlaylist.dat"}; /**< Nama file default untuk database playlist */
+  static constexpr size_t kDefaultColumns = 64; /**< Perkiraan lebar baris */
 
   /**
-   * @brief Menyimpan data bertipe ArrayList ke dalam file biner
+   * @brief Membuat frame kosong dengan kapasitas awal
    *
-   * @tparam T Tipe data dalam ArrayList, harus memiliki method serialize() yang
-   * mengatur proses penyimpanan file
-   * @param filename Nama file tujuan penyimpanan (termasuk ekstensi)
-   * @param data ArrayList berisi elemen yang ingin disiapkan
-   * @return true jika semua elemen berhasil disimpan
-   * @return false jika terjadi error saat penulisan atau serialisasi
+   * @param rows Perkiraan jumlah baris
+   * @param columns Perkiraan jumlah byte per baris
    */
-  template <typename T>
-  static bool save(const std::string& filename, ArrayList<T>& data) {
-    file_ptr = fopen(filename.c_str(), "wb");
+  explicit Frame(size_t rows = 0, size_t columns = kDefaultColumns) {
+    buffer_.reserve(rows * columns);
+    ends_.reserve(rows);
+  }
 
-    if (!file_ptr) {
-      std::cerr << "Tidak dapat membuka file: " << Text::bold(filename)
-                << "!\n";
-      return false;
-    }
+  /**
+   * @brief Menambahkan teks apa adanya ke baris saat ini
+   *
+   */
+  Frame& text(std::string_view text) {
+    buffer_.append(text.data(), text.size());
+    return *this;
+  }
 
-    for (size_t i = 0; i < data.size(); i++) {
-      T& x = data.arr[i];
-      if (!x.serialize()) {
-        fclose(file_ptr);
-        return false;
-      }
-    }
-
-    fclose(file_ptr);
-    return true;
+  /**
+   * @brief Menambahkan teks terformat ke baris saat ini
+   *
+   */
+  Frame& text(const Text::Styled& styled) {
+    styled.appendTo(buffer_);
+    return *this;
   }
 
   /**
-   * @brief Membaca data dari file dan disimpan ke dalam ArrayList
+   * @brief Menambahkan kolom rata kiri selebar width karakter
    *
-   * @tparam T Tipe data yang akan dibaca, harus memiliki method deserialize()
-   * yang mengatur proses pembacaan file
-   * @param filename Nama file sumber data (termasuk ekstensi)
-   * @param data ArrayList tujuan untuk menyimpan hasil pembacaan
-   * @return true jika seluruh operasi pembacaan dan deserialisasi berhasil
-   * @return false jika terjadi error saat pembacaan atau pembukaan file
+   * Teks dipotong menjadi width - 1 karakter agar antar kolom selalu ada
+   * spasi, sama seperti std::setw pada teks yang sudah dipotong.
    */
-  template <typename T>
-  static bool load(const std::string& filename, ArrayList<T>& data) {
-    FileManager::file_ptr = fopen(filename.c_str(), "rb");
-
-    data.clear(); /**< Memastikan vector tujuan dalma keadaan kosong untuk
-                     menghindari duplikasi */
-
-    if (!file_ptr) {
-      std::cerr << "Tidak dapat membuka file: " << Text::bold(filename)
-                << "!\n";
-      return false;
-    }
-
-    while (true) {
-      T x;
-      if (!x.deserialize()) {
-        break;
-      }
-      data.add(x);
-    }
-
-    fclose(FileManager::file_ptr);
-    return true;
+  Frame& cell(std::string_view text, size_t width) {
+    size_t length = std::min(text.size(), width - 1);
+    buffer_.append(text.data(), length);
+    buffer_.append(width - length, ' ');
+    return *this;
   }
 
   /**
-   * @brief Menyimpan data bertipe LinkedList ke dalam file biner
+   * @brief Menambahkan kolom angka rata kiri selebar width karakter
    *
-   * @tparam T tipe elemen dalma linked list, harus memiliki serialize()
-   * @param filename Nama file tujuan
-   * @param data LinkedList yang akan disimpan
-   * @return true jika semua elemen berhasil disimpan
-   * @return false jika terjadi error saat penulisan atau serialisasi
    */
-  template <typename T>
-  static bool save(const std::string& filename, const LinkedList<T>& data) {
-    file_ptr = fopen(filename.c_str(), "wb");
-
-    if (!file_ptr) {
-      std::cerr << "Tidak dapat membuka file: " << Text::bold(filename)
-                << "!\n";
-      return false;
-    }
-
-    Node<T>* node = data.head();
-    while (node) {
-      if (!node->data.serialize()) {
-        fclose(file_ptr);
-        return false;
-      }
-
-      node = node->next;
-    }
-
-    fclose(file_ptr);
-    return true;
+  Frame& cell(size_t number, size_t width) {
+    char digits[24];
+    int length = std::snprintf(digits, sizeof(digits), "%zu", number);
+    return cell(std::string_view(digits, static_cast<size_t>(length)), width);
   }
 
   /**
-   * @brief Membaca data dari file ke dalam LinkedList.
+   * @brief Menambahkan kolom angka bertanda (misalnya tahun rilis)
    *
-   * @tparam T Tipe data yang akan dimasukkan ke dalam list.
-   * @param filename Nama file sumber data.
-   * @param data LinkedList yang akan diisi dengan hasil pembacaan.
-   * @return true Jika semua data berhasil dibaca dan dideserialisasi.
-   * @return false Jika ada kesalahan pembacaan file atau deserialisasi.
    */
-  template <typename T>
-  static bool load(const std::string& filename, LinkedList<T>& data) {
-    file_ptr = fopen(filename.c_str(), "rb");
-    if (!file_ptr) {
-      std::cerr << "Tidak dapat membuka file: " << Text::bold(filename)
-                << "!\n";
-      return false;
-    }
-
-    while (!feof(file_ptr)) {
-      T x;
-      if (!x.deserialize()) {
-        break;
-      }
-      data.push(x);
-    }
-
-    fclose(file_ptr);
-    return true;
+  Frame& cell(long long number, size_t width) {
+    char digits[24];
+    int length = std::snprintf(digits, sizeof(digits), "%lld", number);
+    return cell(std::string_view(digits, static_cast<size_t>(length)), width);
   }
 
   /**
-   * @brief Membaca data dari file.
+   * @brief Menambahkan kolom bertulisan tebal (judul kolom tabel)
    *
-   * @tparam T Tipe data yang ingin dibaca.
-   * @param data Referensi variabel tempat menyimpan hasil pembacaan.
-   * @param length Jumlah elemen yang ingin dibaca (default = 1).
-   * @return true Jika jumlah data yang dibaca sesuai dengan yang diminta.
    */
-  template <typename T>
-  static bool read(T& data, size_t length = 1) {
-    return fread(&data, sizeof(T), length, file_ptr) == length;
+  Frame& boldCell(std::string_view text, size_t width) {
+    size_t length = std::min(text.size(), width - 1);
+    Text::bold(text.substr(0, length)).appendTo(buffer_);
+    buffer_.append(width - length, ' ');
+    return *this;
   }
 
   /**
-   * @brief Membaca string (char array) dari file.
+   * @brief Menambahkan garis horizontal
    *
-   * @param str Buffer tempat menyimpan hasil pembacaan.
-   * @param length Panjang karakter yang akan dibaca.
-   * @return true Jika seluruh karakter berhasil dibaca.
    */
-  static bool read(char* str, size_t length) {
-    return fread(str, sizeof(char), length, file_ptr) == length;
+  Frame& rule(size_t width, char fill = '-') {
+    buffer_.append(width, fill);
+    return *this;
   }
 
   /**
-   * @brief Menulis data ke file.
+   * @brief Menutup baris saat ini
    *
-   * @tparam T Tipe data yang akan ditulis.
-   * @param data Data yang ingin disimpan.
-   * @return true Jika penulisan berhasil.
    */
-  template <typename T>
-  static bool write(const T& data) {
-    return fwrite(&data, sizeof(T), 1, file_ptr) == 1;
+  Frame& endLine() {
+    ends_.push_back(buffer_.size());
+    return *this;
   }
 
+  size_t lines() const { return ends_.size(); }
+  size_t size() const { return buffer_.size(); }
+
   /**
-   * @brief Menulis string (char array) ke file.
+   * @brief Mengambil isi baris tertentu (tanpa newline)
    *
-   * @param str String yang ingin ditulis.
-   * @param length Panjang string yang akan ditulis.
-   * @return true Jika seluruh karakter berhasil ditulis.
    */
-
-  static bool write(const char* str, size_t length) {
-    return fwrite(str, sizeof(char), length, file_ptr) == length;
+  std::string_view line(size_t index) const {
+    size_t begin = index == 0 ? 0 : ends_[index - 1];
+    return std::string_view(buffer_).substr(begin, ends_[index] - begin);
   }
 
  private:
-  static inline FILE* file_ptr{
-      nullptr}; /**< Pointer file global yang digunakan untuk seluruh operasi */
+  std::string buffer_;       /**< Isi seluruh baris */
+  std::vector<size_t> ends_; /**< Posisi akhir setiap baris di buffer_ */
 };
-#pragma endregion
 
-#pragma region Song-Specified
-#pragma region Song Data Structure
 /**
- * @class Song
- * @brief Struct Song merepresentasikan satu entitas lagu dalam sistem.
+ * @class Screen
+ * @brief Lapisan render terminal dengan redraw berbasis selisih (diff)
  *
- * Struct ini menyimpan informasi seperti judul lagu, artis, genre, durasi,
- * tahun rilis, dan jumlah pemutaran. Struct ini juga menyediakan fungsi
- * untuk serialisasi dan deserialisasi sehingga dapat disimpan atau dibaca dari
- * file biner.
+ * Setiap frame ditulis dengan satu panggilan write(). Jika frame sebelumnya
+ * masih tampil di posisi yang sama, hanya baris yang berubah yang ditulis
+ * ulang, mulai dari kolom pertama yang berbeda. Frame yang lebih tinggi dari
+ * terminal ditulis berurutan (boleh menggulung layar) tanpa diff.
  */
-struct Song {
-  static size_t id_counter; /**< variabel static untuk auto-increment ID */
-  size_t id;                /**< ID yang nilainya berdasarkan id_counter */
-  char title[255];          /**< Judul Lagu */
-  char artist[255];         /**< Nama penyanyi / pencipta lagu */
-  char genre[255];          /**< Genre lagu */
-  int release_year;         /**< Tahun rilis lagu */
-  size_t duration;          /**< Durasi lagu dalam detik */
-  size_t play_count;        /**< Jumlah pemutaran lagu */
-
+class Screen {
+ public:
   /**
-   * @brief Constructor default, mengatur id berdasarkan id_counter
+   * @class CoutCapture
+   * @brief Mengalihkan std::cout ke Screen::write() selama objek hidup
    *
+   * Output menu ditampung dan baru ditulis saat std::cout di-flush
+   * (std::endl, std::flush, atau sebelum std::cin membaca karena keduanya
+   * terikat), dengan mutex yang sama dengan baris status pemutar. Dengan
+   * begitu potongan output menu tidak pernah disisipi baris status.
+   * Selama pengalihan aktif, hanya thread UI yang boleh menulis ke std::cout.
    */
-  Song() : id(id_counter) {
-    std::strcpy(title, "");
-    std::strcpy(artist, "");
-    std::strcpy(genre, "");
-  }
+  class CoutCapture : public std::streambuf {
+   public:
+    CoutCapture() : previous_(std::cout.rdbuf(this)) {}
+    CoutCapture(const CoutCapture&) = delete;
+    CoutCapture& operator=(const CoutCapture&) = delete;
+
+    ~CoutCapture() override {
+      sync();
+      std::cout.rdbuf(previous_);
+    }
+
+   protected:
+    int_type overflow(int_type c) override {
+      if (!traits_type::eq_int_type(c, traits_type::eof())) {
+        pending_ += traits_type::to_char_type(c);
+      }
+      return traits_type::not_eof(c);
+    }
+
+    std::streamsize xsputn(const char* data, std::streamsize size) override {
+      pending_.append(data, static_cast<size_t>(size));
+      return size;
+    }
+
+    int sync() override {
+      if (!pending_.empty()) {
+        Screen::write(pending_);
+        pending_.clear();
+      }
+      return 0;
+    }
+
+   private:
+    std::streambuf* previous_; /**< Buffer std::cout sebelum dialihkan */
+    std::string pending_;      /**< Output yang belum ditulis */
+  };
 
   /**
-   * @brief Constructor berparameter untuk membuat Song berdasarkan nilai
-   * spesifik
+   * @brief Menulis data ke terminal dengan satu panggilan write()
    *
-   * @param title Judul lagu
-   * @param artist Nama penyanyi / pencipta
-   * @param genre Genre lagu
-   * @param release_year Tahun rilis lagu
-   * @param duration Durasi waktu dalam detik
-   * @param play_count jumlah pemutaran awal (opsional, default = 0)
+   * Buffer stdio (termasuk std::cout) dikosongkan lebih dulu agar urutan
+   * tampilan tetap benar. Aman dipanggil dari beberapa thread.
+   *
+   * @param data Data yang akan ditulis
    */
-  Song(const char* _title, const char* _artist, const char* _genre,
-       int release_year, size_t duration, size_t play_count = 0)
-      : id(id_counter++),
-        release_year(release_year),
-        duration(duration),
-        play_count(play_count) {
-    std::strncpy(title, _title, 254);
-    std::strncpy(artist, _artist, 254);
-    std::strncpy(genre, _genre, 254);
+  static void write(std::string_view data) {
+    std::lock_guard<std::mutex> lock(output_mutex_);
+    std::fflush(stdout);
+#ifdef __WIN32__
+    std::fwrite(data.data(), 1, data.size(), stdout);
+    std::fflush(stdout);
+#else
+    while (!data.empty()) {
+      ssize_t written = ::write(STDOUT_FILENO, data.data(), data.size());
+      if (written < 0) {
+        if (errno == EINTR) continue;
+        return;
+      }
+      data.remove_prefix(static_cast<size_t>(written));
+    }
+#endif
   }
 
   /**
-   * @brief Operator pembanding untuk mengetahui apakah dua lagu sama.
-   *
-   * Dua lagu dianggap sama jika `title` dan `artist` nya sama.
+   * @brief Menulis frame di posisi kursor saat ini tanpa diff
    *
-   * @param rhs Lagu lain yang ingin dibandingkan.
-   * @return true jika kedua lagu memiliki judul dan artis yang sama.
    */
-  bool operator==(const Song& rhs) const {
-    // return std::memcmp(title, rhs.title, sizeof(title) == 0) &&
-    //        memcmp(artist, rhs.artist, sizeof(title) == 0);
-
-    return id == rhs.id;
+  static void stream(const Frame& frame) {
+    RAIVFY_TIMED(kRender);
+    std::cout.flush();
+    std::string out;
+    out.reserve(frame.size() + frame.lines());
+    for (size_t i = 0; i < frame.lines(); i++) {
+      out.append(frame.line(i).data(), frame.line(i).size());
+      out += '\n';
+    }
+    write(out);
   }
 
   /**
-   * @brief Operator pembanding tidak sama.
+   * @brief Mengambil tinggi terminal (24 jika tidak diketahui)
    *
-   * @param rhs Lagu lain yang ingin dibandingkan.
-   * @return true jika lagu berbeda (berdasarkan title dan artist).
    */
-  bool operator!=(const Song& rhs) const { return !(*this == rhs); }
+  static int terminalRows() {
+#ifndef __WIN32__
+    winsize size{};
+    if (ioctl(STDOUT_FILENO, TIOCGWINSZ, &size) == 0 && size.ws_row > 0) {
+      return size.ws_row;
+    }
+#endif
+    return 24;
+  }
 
   /**
-   * @brief Operasi penyimpanan seluruh atribut lagu ke dalam file biner.
-   *
-   * Fungsi ini digunakan oleh FileManager untuk menyimpan data `Song`
-   * menggunakan fungsi `write()` yang sesuai tipe datanya.
+   * @brief Membersihkan layar dengan ANSI escape code (tanpa subprocess)
    *
-   * @return true jika seluruh proses penulisan berhasil.
    */
-  bool serialize() const {
-    return FileManager::write<size_t>(id) && FileManager::write(title, 255) &&
-           FileManager::write(genre, 255) && FileManager::write(artist, 255) &&
-           FileManager::write<int>(release_year) &&
-           FileManager::write<size_t>(duration) &&
-           FileManager::write<size_t>(play_count);
+  void clear() {
+    std::cout.flush();
+    write("\033[H\033[2J\033[3J");
+    previous_ = Frame();
+    has_previous_ = false;
   }
 
   /**
-   * @brief Operasi pembacaan atribut lagu dari file biner.
+   * @brief Menampilkan frame mulai dari baris top
    *
-   * Fungsi ini digunakan oleh FileManager untuk memuat data `Song`
-   * menggunakan fungsi `read()` yang sesuai tipe datanya.
-   * Panjang string dibaca terlebih dahulu, lalu isinya.
+   * Isi layar di bawah frame (misalnya input sebelumnya) ikut dihapus.
    *
-   * @return true jika seluruh proses pembacaan berhasil.
+   * @param frame Frame yang akan ditampilkan
+   * @param top Baris terminal tempat frame dimulai (mulai dari 1)
    */
-  bool deserialize() {
-    if (!FileManager::read<size_t>(id)) return false;
+  void present(Frame frame, int top = 1) {
+    RAIVFY_TIMED(kRender);
+    std::cout.flush();
+    int rows = terminalRows();
+    bool fits = top + static_cast<int>(frame.lines()) <= rows;
+    bool diff = has_previous_ && top == top_ && fits;
+
+    std::string out;
+    out.reserve(frame.size() + frame.lines() * 12);
+    if (!diff) {
+      if (fits) moveTo(out, top, 1);
+      for (size_t i = 0; i < frame.lines(); i++) {
+        out.append(frame.line(i).data(), frame.line(i).size());
+        out += "\033[K\n";
+      }
+    } else {
+      for (size_t i = 0; i < frame.lines(); i++) {
+        std::string_view line = frame.line(i);
+        size_t column = 0;
+        if (i < previous_.lines()) {
+          std::string_view old = previous_.line(i);
+          if (old == line) continue;
+          column = plainPrefix(old, line);
+        }
 
-    if (!FileManager::read(&title[0], 255)) return false;
-    if (!FileManager::read(&genre[0], 255)) return false;
-    if (!FileManager::read(&artist[0], 255)) return false;
+        moveTo(out, top + static_cast<int>(i), static_cast<int>(column) + 1);
+        out.append(line.data() + column, line.size() - column);
+        out += "\033[K";
+      }
 
-    title[254] = genre[254] = artist[254] = '\0';
+      for (size_t i = frame.lines(); i < previous_.lines(); i++) {
+        moveTo(out, top + static_cast<int>(i), 1);
+        out += "\033[K";
+      }
+      moveTo(out, top + static_cast<int>(frame.lines()), 1);
+      out += "\033[J";
+    }
 
-    if (!FileManager::read<int>(release_year)) return false;
-    if (!FileManager::read<size_t>(duration)) return false;
-    if (!FileManager::read<size_t>(play_count)) return false;
+    write(out);
+    has_previous_ = fits;
+    top_ = top;
+    previous_ = std::move(frame);
+  }
 
-    Song::id_counter++;
-    return true;
+ private:
+  static inline std::mutex output_mutex_; /**< Pelindung penulisan terminal */
+
+  Frame previous_;            /**< Frame yang sedang tampil */
+  bool has_previous_{false};  /**< previous_ masih tampil utuh di layar */
+  int top_{1};                /**< Baris awal previous_ */
+
+  /**
+   * @brief Panjang awalan yang sama dan hanya berisi karakter ASCII biasa
+   *
+   * Awalan berhenti di escape code atau karakter multi-byte agar panjangnya
+   * sama dengan jumlah kolom di terminal.
+   */
+  static size_t plainPrefix(std::string_view a, std::string_view b) {
+    size_t length = 0;
+    size_t limit = std::min(a.size(), b.size());
+    while (length < limit && a[length] == b[length] && a[length] >= 0x20 &&
+           a[length] < 0x7f) {
+      length++;
+    }
+    return length;
+  }
+
+  static void moveTo(std::string& out, int line, int column) {
+    char code[32];
+    int length = std::snprintf(code, sizeof(code), "\033[%d;%dH", line, column);
+    out.append(code, static_cast<size_t>(length));
   }
 };
 #pragma endregion
 
-#pragma region Sorting Algorithm Implementation
+#pragma region StrukturData
+#pragma region Custom Vector-Like
 /**
- * @class SongSorter
- * @brief Implementasi algoritma sorting (pengurutan) untuk objek Song.
+ * @brief Array class
+ *
  *
- * Kelas ini menyediakan metode Bubble Sort dan Quick Sort yang dapat digunakan
- * secara fleksibel dengan comparator untuk berbagai field (judul, id, dll).
  */
-
-class SongSorter {
+template <typename T>
+class ArrayList {
  public:
-  /**
-   * @brief Comparator untuk mengurutkan berdasarkan judul lagu (ascending).
-   *
-   * Comparator digunakan untuk membuat algoritma pengurutan dapat digunakan
-   * secara fleksibel untuk mengurutkan data berdasrkan field tertentu
-   */
-  static inline auto by_title = [](const Song& a, const Song& b) {
-    return std::strcmp(a.title, b.title) < 0;
-  };
+  T* arr{nullptr}; /**< Elemen array, kapasitas bertambah otomatis */
 
-  /**
-   * @brief Comparator untuk mengurutkan berdasarkan ID lagu (ascending).
-   */
-  static inline auto by_id = [](const Song& a, const Song& b) {
-    return a.id < b.id;
-  };
+  ArrayList() { size_ = 0; }
+  ArrayList(const ArrayList& other) { *this = other; }
+  ArrayList(ArrayList&& other) noexcept { swap(other); }
+  ~ArrayList() { delete[] arr; }
+
+  ArrayList& operator=(const ArrayList& other) {
+    if (this == &other) return *this;
+
+    reserve(other.size_);
+    for (size_t i = 0; i < other.size_; i++) arr[i] = other.arr[i];
+    for (size_t i = other.size_; i < size_; i++) arr[i] = T();
+    size_ = other.size_;
+    return *this;
+  }
 
-  /**
-   * @brief Comparator untuk mengurutkan berdasarkan jumlah pemutaran lagu
-   * (ascending).
-   */
-  static inline auto by_play_count = [](const Song& a, const Song& b) {
-    return a.play_count < b.play_count;
-  };
+  ArrayList& operator=(ArrayList&& other) noexcept {
+    swap(other);
+    return *this;
+  }
 
-  /**
-   * @brief Comparator untuk mengurutkan berdasarkan tahun rilis lagu
-   * (ascending).
-   */
-  static inline auto by_release_year = [](const Song& a, const Song& b) {
-    return a.release_year < b.release_year;
-  };
+  size_t size() const { return size_; }
+  bool empty() const { return size_ == 0; }
+  size_t capacity() const { return capacity_; }
 
   /**
-   * @brief Memastikan ArrayList Song telah terurut berdasarkan ID.
+   * @brief Memastikan kapasitas cukup untuk sejumlah elemen
    *
-   * Memilih algoritma quickSort untuk data > 30 elemen, bubbleSort jika ≤ 30.
-   * @param data ArrayList lagu yang akan diurutkan.
+   * @param capacity Kapasitas minimum
    */
-  static void ensureSortedByID(ArrayList<Song>& data) {
-    if (data.size() > kQuickSortThreshold) {
-      quickSort(data, 0, data.size() - 1, by_id);
-    } else {
-      bubbleSort(data, by_id);
-    }
+  void reserve(size_t capacity) {
+    if (capacity <= capacity_) return;
+
+    T* grown = new T[capacity];
+    RAIVFY_COUNT(kAllocations, 1);
+    RAIVFY_COUNT(kAllocatedBytes, capacity * sizeof(T));
+    for (size_t i = 0; i < size_; i++) grown[i] = std::move(arr[i]);
+    delete[] arr;
+    arr = grown;
+    capacity_ = capacity;
   }
 
-  /**
-   * @brief Mengurutkan data menggunakan Bubble Sort.
-   *
-   * @param data ArrayList data lagu.
-   * @param comparator Fungsi pembanding untuk menentukan urutan.
-   */
-  static void bubbleSort(
-      ArrayList<Song>& data,
-      std::function<bool(const Song&, const Song&)> comparator) {
-    if (data.empty()) return;
+  void add(const T& new_data) {
+    if (size_ == capacity_) {
+      reserve(capacity_ == 0 ? kInitialCapacity : capacity_ * 2);
+    }
+    arr[size_] = new_data;
+    ++size_;
+  }
 
-    for (size_t i = 0; i < data.size(); ++i) {
-      for (size_t j = 0; j < data.size() - i - 1; ++j) {
-        if (comparator(data.arr[j + 1], data.arr[j])) {
-          swap(&data.arr[j], &data.arr[j + 1]);
-        }
-      }
+  void clear() {
+    for (size_t i = 0; i < size_; i++) {
+      arr[i] = T();
     }
+    size_ = 0;
   }
 
-  /**
-   * @brief Mengurutkan data menggunakan Quick Sort.
+  void decreaseSize() {
+    arr[size_ - 1] = T();
+    size_--;
+  }
+
+ private:
+  static constexpr size_t kInitialCapacity = 16; /**< Kapasitas awal */
+
+  size_t size_{0};     /**< Jumlah elemen */
+  size_t capacity_{0}; /**< Jumlah elemen yang sudah dialokasikan */
+
+  void swap(ArrayList& other) noexcept {
+    std::swap(arr, other.arr);
+    std::swap(size_, other.size_);
+    std::swap(capacity_, other.capacity_);
+  }
+};
+#pragma endregion
+#pragma region LinkedList Ganda
+/**
+ * @class Node
+ * @brief Struktur Node untuk Implementasi Linked List Ganda.
+ *
+ * @tparam T Tipe data yang akan disimpan dalam node
+ */
+template <typename T>
+struct Node {
+  T data;            /**< Data yang akan disimpan dalam node */
+  Node<T>* next;     /**< Pointer ke node selanjutnya */
+  Node<T>* previous; /**< Pointer ke node sebelumnya */
+
+  Node() = default;
+
+  /**
+   * @brief Constructor Node baru dengan data
+   *
+   * @param data Nilai awal yang akan disimpan dalam node
+   *
+   * Pointer node sebelumnya dan selanjutnya akan otomatis memiliki nilai
+   * nullptr
+   */
+  Node(const T& data) : data(data), next(nullptr), previous(nullptr) {}
+};
+
+/**
+ * @class NodePool
+ * @brief Allocator node berbasis slab (blok memori) dengan free-list
+ *
+ * Node dialokasikan dari blok berisi BlockSize slot yang berurutan sehingga
+ * node yang ditambahkan berturut-turut berada berdekatan di memori. Node yang
+ * dihapus dikembalikan ke free-list untuk dipakai ulang, dan seluruh node dapat
+ * dilepas sekaligus dengan clear() tanpa mengembalikan blok ke sistem.
+ *
+ * @tparam NodeType Tipe node yang dialokasikan
+ * @tparam BlockSize Jumlah slot node dalam satu blok
+ */
+template <typename NodeType, size_t BlockSize = 64>
+class NodePool {
+ public:
+  NodePool() = default;
+
+  /**
+   * @brief Pool tidak ikut disalin, salinan selalu dimulai dari pool kosong
+   *
+   */
+  NodePool(const NodePool&) : NodePool() {}
+  NodePool& operator=(const NodePool&) { return *this; }
+
+  NodePool(NodePool&& other) noexcept { swap(other); }
+  NodePool& operator=(NodePool&& other) noexcept {
+    if (this != &other) {
+      release();
+      swap(other);
+    }
+    return *this;
+  }
+
+  ~NodePool() { release(); }
+
+  /**
+   * @brief Membuat node baru di dalam pool
+   *
+   * @param args Argumen constructor node
+   * @return NodeType* Pointer ke node baru
+   */
+  template <typename... Args>
+  NodeType* create(Args&&... args) {
+    void* memory = nullptr;
+
+    if (free_list_) {
+      memory = free_list_;
+      free_list_ = free_list_->next;
+    } else {
+      if (!current_ || used_ == BlockSize) nextBlock();
+      memory = &current_->slots[used_++];
+    }
+
+    return new (memory) NodeType(std::forward<Args>(args)...);
+  }
+
+  /**
+   * @brief Menghapus satu node dan mengembalikan slotnya ke free-list
+   *
+   * @param node Node yang akan dihapus
+   */
+  void destroy(NodeType* node) {
+    node->~NodeType();
+
+    Slot* slot = reinterpret_cast<Slot*>(node);
+    slot->next = free_list_;
+    free_list_ = slot;
+  }
+
+  /**
+   * @brief Menghapus seluruh node sekaligus, blok memori tetap disimpan
+   *
+   * @param head Node pertama, digunakan untuk memanggil destructor data jika
+   * tipe node tidak trivially destructible
+   */
+  void clear(NodeType* head) {
+    if (!std::is_trivially_destructible<NodeType>::value) {
+      while (head) {
+        NodeType* next_node = head->next;
+        head->~NodeType();
+        head = next_node;
+      }
+    }
+
+    current_ = first_;
+    used_ = 0;
+    free_list_ = nullptr;
+  }
+
+  /**
+   * @brief Mengembalikan seluruh blok memori ke sistem
+   *
+   * Pastikan seluruh node sudah dihapus melalui clear() sebelumnya.
+   */
+  void release() {
+    while (first_) {
+      Block* next_block = first_->next;
+      delete first_;
+      first_ = next_block;
+    }
+
+    current_ = nullptr;
+    used_ = 0;
+    free_list_ = nullptr;
+    block_count_ = 0;
+  }
+
+  /**
+   * @brief Mengambil besar memori yang dipesan oleh pool
+   *
+   * @return size_t Jumlah byte seluruh blok milik pool
+   */
+  size_t capacityBytes() const { return block_count_ * sizeof(Block); }
+
+ private:
+  /**
+   * @brief Satu slot memori yang dapat berisi node atau pointer free-list
+   *
+   */
+  union Slot {
+    Slot* next;
+    alignas(NodeType) unsigned char storage[sizeof(NodeType)];
+  };
+
+  /**
+   * @brief Satu blok memori berisi slot-slot node yang berurutan
+   *
+   */
+  struct Block {
+    Block* next{nullptr};
+    Slot slots[BlockSize];
+  };
+
+  Block* first_{nullptr};   /**< Blok pertama milik pool */
+  Block* current_{nullptr}; /**< Blok yang sedang diisi */
+  size_t used_{0};          /**< Jumlah slot terpakai pada blok current_ */
+  Slot* free_list_{nullptr};  /**< Slot bekas node yang sudah dihapus */
+  size_t block_count_{0};     /**< Jumlah blok milik pool */
+
+  /**
+   * @brief Berpindah ke blok berikutnya, membuat blok baru jika belum ada
+   *
+   */
+  void nextBlock() {
+    Block* next_block = current_ ? current_->next : first_;
+
+    if (!next_block) {
+      next_block = new Block;
+      block_count_++;
+      RAIVFY_COUNT(kAllocations, 1);
+      RAIVFY_COUNT(kAllocatedBytes, sizeof(Block));
+
+      if (current_) {
+        current_->next = next_block;
+      } else {
+        first_ = next_block;
+      }
+    }
+
+    current_ = next_block;
+    used_ = 0;
+  }
+
+  void swap(NodePool& other) noexcept {
+    std::swap(first_, other.first_);
+    std::swap(current_, other.current_);
+    std::swap(used_, other.used_);
+    std::swap(free_list_, other.free_list_);
+    std::swap(block_count_, other.block_count_);
+  }
+};
+
+/**
+ * @class HeapNodeAllocator
+ * @brief Allocator node sederhana yang memakai new / delete untuk setiap node
+ *
+ * @tparam NodeType Tipe node yang dialokasikan
+ */
+template <typename NodeType>
+class HeapNodeAllocator {
+ public:
+  template <typename... Args>
+  NodeType* create(Args&&... args) {
+    allocated_++;
+    return new NodeType(std::forward<Args>(args)...);
+  }
+
+  void destroy(NodeType* node) {
+    allocated_--;
+    delete node;
+  }
+
+  void clear(NodeType* head) {
+    while (head) {
+      NodeType* next_node = head->next;
+      destroy(head);
+      head = next_node;
+    }
+  }
+
+  void release() {}
+
+  size_t capacityBytes() const { return allocated_ * sizeof(NodeType); }
+
+ private:
+  size_t allocated_{0}; /**< Jumlah node yang masih hidup */
+};
+
+/**
+ * @class LinkedList
+ * @brief Implementasi Linked List Ganda
+ *
+ * @tparam T Tipe data yang akan disimpan dalam list
+ * @tparam Allocator Policy alokasi node (default: NodePool)
+ */
+template <typename T, typename Allocator = NodePool<Node<T>>>
+class LinkedList {
+ public:
+  /**
+   * @brief Constructor default untuk membuat Linked List Ganda
+   *
+   * Pointer awal dan akhir (head and tail) akan otomatis memiliki nilai nullptr
+   * artinya Linked List dalam kondisi kosong
+   */
+  LinkedList() : head_(nullptr), tail_(nullptr), node_counter_(0) {}
+
+  /**
+   * @brief Constructor salinan, seluruh node disalin ke allocator milik list
+   *
+   * @param other Linked List sumber
+   */
+  LinkedList(const LinkedList& other) : LinkedList() { copyFrom(other); }
+
+  LinkedList(LinkedList&& other) noexcept : LinkedList() { swap(other); }
+
+  LinkedList& operator=(const LinkedList& other) {
+    if (this != &other) {
+      clear();
+      copyFrom(other);
+    }
+    return *this;
+  }
+
+  LinkedList& operator=(LinkedList&& other) noexcept {
+    if (this != &other) {
+      clear();
+      swap(other);
+    }
+    return *this;
+  }
+
+  ~LinkedList() { releaseMemory(); }
+
+  /**
+   * @brief Mengambil jumlah node dalam linked list
+   *
+   * @return const int jumlah node saat ini
+   */
+  int count() { return node_counter_; }
+
+  /**
+   * @brief Mengambil pointer ke node kepala atau awal
+   *
+   * @return Node<T>* Pointer ke kepala / awal
+   */
+  Node<T>* head() const { return head_; }
+
+  /**
+   * @brief Mengambil pointer ke node ekor atau akhir
+   *
+   * @return Node<T>* Pointer ke ekor / akhir
+   */
+  Node<T>* tail() const { return tail_; }
+
+  /**
+   * @brief Menambahkan elemen ke bagian belakang list
+   *
+   * @param data Nilai yang akan ditambahkan
+   */
+  void push(const T& data) {
+    Node<T>* new_node = allocator_.create(data);
+    if (isEmpty()) {
+      node_counter_++;
+      head_ = tail_ = new_node;
+      return;
+    }
+
+    tail_->next = new_node;
+    new_node->previous = tail_;
+    tail_ = new_node;
+
+    node_counter_++;
+  }
+
+  /**
+   * @brief Menambahkan elemen ke bagian depan atau tengah list
+   *
+   * @param data Nilai yang akan ditambahkan
+   * @param position Urutan dimana node akan ditambahkan (0 = depan)
+   */
+  void insert(const T& data, int position = 0) {
+    if (isEmpty() || position <= 0) {
+      Node<T>* new_node = allocator_.create(data);
+      node_counter_++;
+
+      if (isEmpty()) {
+        head_ = tail_ = new_node;
+        return;
+      }
+
+      new_node->next = head_;
+      head_->previous = new_node;
+
+      head_ = new_node;
+      return;
+    }
+
+    Node<T>* iterator = head_;
+
+    for (int i = 0; i < position - 1 && isNotNull(iterator); i++) {
+      iterator = iterator->next;
+    }
+
+    if (isNull(iterator)) {
+      push(data);
+      return;
+    }
+
+    Node<T>* new_node = allocator_.create(data);
+    node_counter_++;
+
+    new_node->next = iterator->next;
+    new_node->previous = iterator;
+
+    if (isNotNull(new_node->next)) {
+      new_node->next->previous = new_node;
+    } else {
+      tail_ = new_node;
+    }
+
+    iterator->next = new_node;
+  }
+
+  /**
+   * @brief Menghapus node berdasarkan isi data
+   *
+   * @param data data yang akan dihapus
+   */
+  void deleteNode(const T& data) {
+    if (isEmpty()) return;
+
+    Node<T>* target_node = head_;
+    while (isNotNull(target_node) && target_node->data != data) {
+      target_node = target_node->next;
+    }
+
+    if (isNull(target_node)) return;
+
+    if (isNotNull(target_node->previous)) {
+      target_node->previous->next = target_node->next;
+    } else {
+      head_ = target_node->next;
+    }
+
+    if (target_node->next) {
+      target_node->next->previous = target_node->previous;
+    } else {
+      tail_ = target_node->previous;
+    }
+
+    allocator_.destroy(target_node);
+
+    node_counter_--;
+  }
+
+  /**
+   * @brief Membalik urutan elemen dalam Linked List
+   *
+   */
+  void reverse() {
+    if (isEmpty()) return;
+
+    Node<T>* previous_node = nullptr;
+    Node<T>* current_node = head_;
+    Node<T>* next_node = nullptr;
+
+    tail_ = head_;
+
+    while (isNotNull(current_node)) {
+      next_node = current_node->next;
+      current_node->next = previous_node;
+      current_node->previous = next_node;
+
+      previous_node = current_node;
+      current_node = next_node;
+    }
+
+    head_ = previous_node;
+  }
+
+  /**
+   * @brief Menghapus seluruh elemen dari linked list
+   *
+   */
+  void clear() {
+    allocator_.clear(head_);
+
+    head_ = tail_ = nullptr;
+    node_counter_ = 0;
+  }
+
+  /**
+   * @brief Menghapus seluruh elemen dan mengembalikan memori allocator
+   *
+   */
+  void releaseMemory() {
+    clear();
+    allocator_.release();
+  }
+
+  /**
+   * @brief Mengambil besar memori yang dipakai node-node list
+   *
+   * @return size_t Jumlah byte yang dipesan allocator
+   */
+  size_t memoryUsage() const { return allocator_.capacityBytes(); }
+
+  /**
+   * @brief Mengecek apakah linked list kosong
+   *
+   * @return false jika linked list memiliki node / elemen
+   * @return true jika linked list kosong
+   */
+  bool isEmpty() { return !head_; }
+
+ private:
+  Node<T>* head_;       /**< Pointer ke elemen kepala / awal */
+  Node<T>* tail_;       /**< Pointer ke elemen ekor / akhir */
+  size_t node_counter_; /**< Jumlah elemen dallam list */
+  Allocator allocator_; /**< Allocator pemilik seluruh node list */
+
+  /**
+   * @brief Menyalin seluruh elemen list lain ke bagian belakang list ini
+   *
+   * @param other Linked List sumber
+   */
+  void copyFrom(const LinkedList& other) {
+    for (Node<T>* node = other.head_; node; node = node->next) {
+      push(node->data);
+    }
+  }
+
+  void swap(LinkedList& other) noexcept {
+    std::swap(head_, other.head_);
+    std::swap(tail_, other.tail_);
+    std::swap(node_counter_, other.node_counter_);
+    std::swap(allocator_, other.allocator_);
+  }
+
+  /**
+   * @brief Mengecek apakah node kosong
+   *
+   * @param node Pointer node yang ingin dicek
+   * @return true jika elemen kosong
+   * @return false jika elemen memiliki nilai / isi
+   */
+  bool isNull(Node<T>* node) { return !node; }
+  bool isNotNull(Node<T>* node) { return node; }
+};
+#pragma endregion
+#pragma region Indexed List (Implicit Treap)
+/**
+ * @class TreapNode
+ * @brief Struktur Node untuk Implementasi IndexedList (implicit treap).
+ *
+ * Selain pointer pohon (left, right, parent), node juga menyimpan pointer
+ * next dan previous sesuai urutan elemen sehingga iterasi dapat dilakukan
+ * seperti pada Linked List Ganda.
+ *
+ * @tparam T Tipe data yang akan disimpan dalam node
+ */
+template <typename T>
+struct TreapNode {
+  T data;                  /**< Data yang akan disimpan dalam node */
+  TreapNode<T>* next;      /**< Pointer ke elemen selanjutnya (urutan list) */
+  TreapNode<T>* previous;  /**< Pointer ke elemen sebelumnya (urutan list) */
+  TreapNode<T>* left;      /**< Anak kiri pada pohon */
+  TreapNode<T>* right;     /**< Anak kanan pada pohon */
+  TreapNode<T>* parent;    /**< Induk pada pohon */
+  uint32_t priority;       /**< Prioritas acak untuk menjaga keseimbangan */
+  size_t size;             /**< Jumlah node pada subtree ini */
+
+  /**
+   * @brief Constructor Node baru dengan data dan prioritas
+   *
+   * @param value Nilai awal yang akan disimpan dalam node
+   * @param prio Prioritas heap node
+   */
+  TreapNode(const T& value, uint32_t prio)
+      : data(value),
+        next(nullptr),
+        previous(nullptr),
+        left(nullptr),
+        right(nullptr),
+        parent(nullptr),
+        priority(prio),
+        size(1) {}
+};
+
+/**
+ * @class IndexedList
+ * @brief List berurutan berbasis implicit treap dengan akses posisi O(log n)
+ *
+ * Elemen diurutkan berdasarkan posisi (bukan nilai). Akses, penyisipan,
+ * penghapusan berdasarkan posisi, pemindahan rentang, serta split / concat
+ * berjalan dalam O(log n). Iterasi tetap memakai head() dan pointer next
+ * seperti LinkedList.
+ *
+ * Node dialokasikan dari allocator yang dapat dibagi antar list hasil split(),
+ * sehingga concat() cukup menyambungkan pohon tanpa menyalin node.
+ *
+ * @tparam T Tipe data yang akan disimpan dalam list
+ * @tparam Allocator Policy alokasi node (default: NodePool)
+ */
+template <typename T, typename Allocator = NodePool<TreapNode<T>>>
+class IndexedList {
+ public:
+  using NodeType = TreapNode<T>;
+
+  IndexedList() = default;
+
+  /**
+   * @brief Constructor salinan, seluruh elemen disalin ke allocator baru
+   *
+   * @param other IndexedList sumber
+   */
+  IndexedList(const IndexedList& other) { copyFrom(other); }
+
+  IndexedList(IndexedList&& other) noexcept { swap(other); }
+
+  IndexedList& operator=(const IndexedList& other) {
+    if (this != &other) {
+      releaseMemory();
+      copyFrom(other);
+    }
+    return *this;
+  }
+
+  IndexedList& operator=(IndexedList&& other) noexcept {
+    if (this != &other) {
+      releaseMemory();
+      swap(other);
+    }
+    return *this;
+  }
+
+  ~IndexedList() { clear(); }
+
+  /**
+   * @brief Mengambil jumlah elemen dalam list
+   *
+   * @return size_t Jumlah elemen saat ini
+   */
+  size_t count() const { return sizeOf(root_); }
+
+  /**
+   * @brief Mengecek apakah list kosong
+   *
+   * @return true jika list tidak memiliki elemen
+   */
+  bool isEmpty() const { return !root_; }
+
+  /**
+   * @brief Mengambil pointer ke elemen pertama
+   *
+   * @return NodeType* Pointer ke elemen pertama (nullptr jika kosong)
+   */
+  NodeType* head() const { return head_; }
+
+  /**
+   * @brief Mengambil pointer ke elemen terakhir
+   *
+   * @return NodeType* Pointer ke elemen terakhir (nullptr jika kosong)
+   */
+  NodeType* tail() const { return tail_; }
+
+  /**
+   * @brief Mengambil elemen pada posisi tertentu dalam O(log n)
+   *
+   * @param position Posisi elemen (mulai dari 0)
+   * @return NodeType* Pointer ke node, nullptr jika posisi di luar batas
+   */
+  NodeType* at(size_t position) const {
+    NodeType* node = root_;
+
+    while (node) {
+      size_t left_size = sizeOf(node->left);
+      if (position < left_size) {
+        node = node->left;
+      } else if (position == left_size) {
+        return node;
+      } else {
+        position -= left_size + 1;
+        node = node->right;
+      }
+    }
+
+    return nullptr;
+  }
+
+  /**
+   * @brief Mengambil posisi sebuah node dalam list dalam O(log n)
+   *
+   * @param node Node milik list ini
+   * @return size_t Posisi node (mulai dari 0)
+   */
+  size_t indexOf(const NodeType* node) const {
+    size_t position = sizeOf(node->left);
+
+    while (node->parent) {
+      if (node == node->parent->right) {
+        position += sizeOf(node->parent->left) + 1;
+      }
+      node = node->parent;
+    }
+
+    return position;
+  }
+
+  /**
+   * @brief Menambahkan elemen ke bagian belakang list
+   *
+   * @param data Nilai yang akan ditambahkan
+   * @return NodeType* Node baru
+   */
+  NodeType* push(const T& data) { return insert(data, count()); }
+
+  /**
+   * @brief Menyisipkan elemen pada posisi tertentu
+   *
+   * @param data Nilai yang akan ditambahkan
+   * @param position Posisi elemen baru (0 = depan, >= count() = belakang)
+   * @return NodeType* Node baru
+   */
+  NodeType* insert(const T& data, size_t position) {
+    position = std::min(position, count());
+
+    NodeType* new_node = allocator().create(data, nextPriority());
+    NodeType* before = position > 0 ? at(position - 1) : nullptr;
+    NodeType* after = before ? before->next : head_;
+    link(before, new_node);
+    link(new_node, after);
+
+    NodeType *left_part, *right_part;
+    split(root_, position, left_part, right_part);
+    setRoot(merge(merge(left_part, new_node), right_part));
+    return new_node;
+  }
+
+  /**
+   * @brief Menghapus elemen pada posisi tertentu
+   *
+   * @param position Posisi elemen yang dihapus
+   */
+  void erase(size_t position) {
+    NodeType* node = at(position);
+    if (node) erase(node);
+  }
+
+  /**
+   * @brief Menghapus node tertentu dalam O(log n)
+   *
+   * @param node Node milik list ini yang akan dihapus
+   */
+  void erase(NodeType* node) {
+    size_t position = indexOf(node);
+    link(node->previous, node->next);
+
+    NodeType *left_part, *middle, *right_part;
+    split(root_, position, left_part, middle);
+    split(middle, 1, middle, right_part);
+    setRoot(merge(left_part, right_part));
+
+    allocator().destroy(node);
+  }
+
+  /**
+   * @brief Menghapus elemen pertama yang bernilai sama dengan data
+   *
+   * @param data data yang akan dihapus
+   * @return true jika ada elemen yang dihapus
+   */
+  bool deleteNode(const T& data) {
+    for (NodeType* node = head_; node; node = node->next) {
+      if (node->data == data) {
+        erase(node);
+        return true;
+      }
+    }
+    return false;
+  }
+
+  /**
+   * @brief Memindahkan rentang elemen [first, last) ke posisi lain
+   *
+   * @param first Posisi awal rentang
+   * @param last Posisi akhir rentang (eksklusif)
+   * @param destination Posisi awal rentang setelah dipindahkan, dihitung
+   * pada list tanpa rentang tersebut
+   */
+  void moveRange(size_t first, size_t last, size_t destination) {
+    last = std::min(last, count());
+    if (first >= last) return;
+
+    NodeType *before, *range, *after;
+    split(root_, last, before, after);
+    split(before, first, before, range);
+
+    NodeType* range_head = leftmost(range);
+    NodeType* range_tail = rightmost(range);
+    link(range_head->previous, range_tail->next);
+
+    NodeType* rest = merge(before, after);
+    destination = std::min(destination, sizeOf(rest));
+    split(rest, destination, before, after);
+
+    link(rightmost(before), range_head);
+    link(range_tail, leftmost(after));
+    setRoot(merge(merge(before, range), after));
+  }
+
+  /**
+   * @brief Memotong list pada posisi tertentu
+   *
+   * Elemen [0, position) tetap di list ini, sisanya dipindahkan ke list baru
+   * yang memakai allocator yang sama.
+   *
+   * @param position Posisi pemotongan
+   * @return IndexedList List berisi elemen [position, count())
+   */
+  IndexedList split(size_t position) {
+    IndexedList suffix;
+    suffix.allocator_ = allocator_;
+
+    NodeType *left_part, *right_part;
+    split(root_, position, left_part, right_part);
+
+    NodeType* left_tail = rightmost(left_part);
+    if (left_tail) left_tail->next = nullptr;
+    NodeType* right_head = leftmost(right_part);
+    if (right_head) right_head->previous = nullptr;
+
+    setRoot(left_part);
+    suffix.setRoot(right_part);
+    return suffix;
+  }
+
+  /**
+   * @brief Menyambungkan list lain ke bagian belakang list ini
+   *
+   * Jika kedua list memakai allocator yang sama (misalnya hasil split()),
+   * penyambungan berjalan dalam O(log n). Jika tidak, elemen disalin.
+   *
+   * @param other List yang akan disambung, akan menjadi kosong
+   */
+  void concat(IndexedList& other) {
+    if (this == &other || other.isEmpty()) return;
+
+    if (!allocator_ || allocator_ == other.allocator_) {
+      allocator_ = other.allocator_;
+      link(tail_, other.head_);
+      setRoot(merge(root_, other.root_));
+      other.setRoot(nullptr);
+      return;
+    }
+
+    for (NodeType* node = other.head_; node; node = node->next) {
+      push(node->data);
+    }
+    other.clear();
+  }
+
+  /**
+   * @brief Membalik urutan elemen dalam list
+   *
+   */
+  void reverse() {
+    NodeType* node = head_;
+
+    while (node) {
+      NodeType* next_node = node->next;
+      std::swap(node->left, node->right);
+      std::swap(node->next, node->previous);
+      node = next_node;
+    }
+
+    std::swap(head_, tail_);
+  }
+
+  /**
+   * @brief Menghapus seluruh elemen dari list
+   *
+   * Jika allocator hanya dipakai list ini, seluruh node dilepas sekaligus.
+   */
+  void clear() {
+    if (allocator_ && allocator_.use_count() == 1) {
+      allocator_->clear(head_);
+    } else {
+      while (head_) {
+        NodeType* next_node = head_->next;
+        allocator_->destroy(head_);
+        head_ = next_node;
+      }
+    }
+
+    root_ = head_ = tail_ = nullptr;
+  }
+
+  /**
+   * @brief Menghapus seluruh elemen dan melepas allocator milik list
+   *
+   */
+  void releaseMemory() {
+    clear();
+    allocator_.reset();
+  }
+
+  /**
+   * @brief Mengambil besar memori yang dipakai node-node list
+   *
+   * @return size_t Jumlah byte yang dipesan allocator
+   */
+  size_t memoryUsage() const {
+    return allocator_ ? allocator_->capacityBytes() : 0;
+  }
+
+ private:
+  NodeType* root_{nullptr}; /**< Akar pohon treap */
+  NodeType* head_{nullptr}; /**< Pointer ke elemen pertama */
+  NodeType* tail_{nullptr}; /**< Pointer ke elemen terakhir */
+  std::shared_ptr<Allocator> allocator_; /**< Allocator pemilik node */
+
+  static size_t sizeOf(const NodeType* node) { return node ? node->size : 0; }
+
+  /**
+   * @brief Menghitung ulang ukuran subtree dan parent anak-anak node
+   *
+   */
+  static void update(NodeType* node) {
+    node->size = 1 + sizeOf(node->left) + sizeOf(node->right);
+    if (node->left) node->left->parent = node;
+    if (node->right) node->right->parent = node;
+  }
+
+  /**
+   * @brief Memisahkan pohon menjadi [0, position) dan [position, size)
+   *
+   */
+  static void split(NodeType* node, size_t position, NodeType*& left_part,
+                    NodeType*& right_part) {
+    if (!node) {
+      left_part = right_part = nullptr;
+      return;
+    }
+
+    if (sizeOf(node->left) < position) {
+      split(node->right, position - sizeOf(node->left) - 1, node->right,
+            right_part);
+      left_part = node;
+    } else {
+      split(node->left, position, left_part, node->left);
+      right_part = node;
+    }
+
+    update(node);
+    if (left_part) left_part->parent = nullptr;
+    if (right_part) right_part->parent = nullptr;
+  }
+
+  /**
+   * @brief Menggabungkan dua pohon, seluruh elemen left_part berada di depan
+   *
+   */
+  static NodeType* merge(NodeType* left_part, NodeType* right_part) {
+    if (!left_part) return right_part;
+    if (!right_part) return left_part;
+
+    if (left_part->priority > right_part->priority) {
+      left_part->right = merge(left_part->right, right_part);
+      update(left_part);
+      return left_part;
+    }
+
+    right_part->left = merge(left_part, right_part->left);
+    update(right_part);
+    return right_part;
+  }
+
+  static NodeType* leftmost(NodeType* node) {
+    while (node && node->left) node = node->left;
+    return node;
+  }
+
+  static NodeType* rightmost(NodeType* node) {
+    while (node && node->right) node = node->right;
+    return node;
+  }
+
+  /**
+   * @brief Menyambungkan pointer next / previous dua node yang berurutan
+   *
+   */
+  static void link(NodeType* before, NodeType* after) {
+    if (before) before->next = after;
+    if (after) after->previous = before;
+  }
+
+  void setRoot(NodeType* root) {
+    root_ = root;
+    if (root_) root_->parent = nullptr;
+    head_ = leftmost(root_);
+    tail_ = rightmost(root_);
+  }
+
+  Allocator& allocator() {
+    if (!allocator_) allocator_ = std::make_shared<Allocator>();
+    return *allocator_;
+  }
+
+  static uint32_t nextPriority() {
+    static thread_local std::minstd_rand generator{std::random_device{}()};
+    return static_cast<uint32_t>(generator());
+  }
+
+  void copyFrom(const IndexedList& other) {
+    for (NodeType* node = other.head_; node; node = node->next) {
+      push(node->data);
+    }
+  }
+
+  void swap(IndexedList& other) noexcept {
+    std::swap(root_, other.root_);
+    std::swap(head_, other.head_);
+    std::swap(tail_, other.tail_);
+    std::swap(allocator_, other.allocator_);
+  }
+};
+#pragma endregion
+#pragma region Lock-Free Ring Buffer
+/**
+ * @class SpscRing
+ * @brief Antrian melingkar lock-free untuk satu producer dan satu consumer
+ *
+ * Producer hanya menulis indeks tail_, consumer hanya menulis indeks head_,
+ * sehingga push() dan pop() tidak pernah memakai mutex maupun menunggu satu
+ * sama lain. Jika antrian penuh, push() langsung gagal.
+ *
+ * @tparam T Tipe elemen antrian
+ * @tparam Capacity Kapasitas antrian, harus kelipatan dua (power of two)
+ */
+template <typename T, size_t Capacity>
+class SpscRing {
+  static_assert((Capacity & (Capacity - 1)) == 0,
+                "Kapasitas harus kelipatan dua!");
+
+ public:
+  /**
+   * @brief Menambahkan elemen ke antrian (hanya dari thread producer)
+   *
+   * @param value Elemen yang akan ditambahkan
+   * @return true jika berhasil, false jika antrian penuh
+   */
+  bool push(const T& value) {
+    size_t tail = tail_.load(std::memory_order_relaxed);
+    if (tail - head_.load(std::memory_order_acquire) == Capacity) return false;
+
+    buffer_[tail & (Capacity - 1)] = value;
+    tail_.store(tail + 1, std::memory_order_release);
+    return true;
+  }
+
+  /**
+   * @brief Mengambil elemen terdepan antrian (hanya dari thread consumer)
+   *
+   * @param value Tempat menyimpan elemen yang diambil
+   * @return true jika ada elemen yang diambil, false jika antrian kosong
+   */
+  bool pop(T& value) {
+    size_t head = head_.load(std::memory_order_relaxed);
+    if (head == tail_.load(std::memory_order_acquire)) return false;
+
+    value = buffer_[head & (Capacity - 1)];
+    head_.store(head + 1, std::memory_order_release);
+    return true;
+  }
+
+ private:
+  T buffer_[Capacity]{}; /**< Penyimpanan elemen */
+  alignas(64) std::atomic<size_t> head_{0}; /**< Indeks baca (consumer) */
+  alignas(64) std::atomic<size_t> tail_{0}; /**< Indeks tulis (producer) */
+};
+#pragma endregion
+
+#pragma region Ordered Index (Sorted Array + Delta)
+/**
+ * @class OrderedIndex
+ * @brief Index terurut (key, id) untuk range query dan count query
+ *
+ * Sebagian besar entry berada di array utama yang terurut. Penambahan baru
+ * masuk ke delta buffer kecil yang juga terurut, penghapusan entry array
+ * utama dicatat sebagai tombstone. Jika delta atau tombstone sudah melebihi
+ * sekitar akar jumlah entry, keduanya digabung ke array utama, sehingga
+ * biaya perubahan tetap kecil tanpa membuat query melambat.
+ *
+ * Range query O(log n + k) dengan menelusuri array utama dan delta secara
+ * bersamaan, count query O(log n) cukup dengan binary search.
+ */
+class OrderedIndex {
+ public:
+  /**
+   * @brief Satu entry index, diurutkan berdasarkan key lalu id
+   *
+   */
+  struct Entry {
+    long long key; /**< Nilai kolom */
+    size_t id;     /**< ID record */
+
+    bool operator<(const Entry& other) const {
+      return key != other.key ? key < other.key : id < other.id;
+    }
+    bool operator==(const Entry& other) const {
+      return key == other.key && id == other.id;
+    }
+  };
+
+  /**
+   * @brief Membangun ulang index dari seluruh entry
+   *
+   */
+  void build(std::vector<Entry> entries) {
+    std::sort(entries.begin(), entries.end());
+    main_ = std::move(entries);
+    delta_.clear();
+    removed_.clear();
+  }
+
+  void insert(long long key, size_t id) {
+    Entry entry{key, id};
+    auto removed = std::lower_bound(removed_.begin(), removed_.end(), entry);
+    if (removed != removed_.end() && *removed == entry) {
+      removed_.erase(removed);
+      return;
+    }
+
+    delta_.insert(std::upper_bound(delta_.begin(), delta_.end(), entry), entry);
+    if (delta_.size() > mergeThreshold()) merge();
+  }
+
+  void erase(long long key, size_t id) {
+    Entry entry{key, id};
+    auto pending = std::lower_bound(delta_.begin(), delta_.end(), entry);
+    if (pending != delta_.end() && *pending == entry) {
+      delta_.erase(pending);
+      return;
+    }
+
+    if (!std::binary_search(main_.begin(), main_.end(), entry)) return;
+    removed_.insert(
+        std::upper_bound(removed_.begin(), removed_.end(), entry), entry);
+    if (removed_.size() > mergeThreshold()) merge();
+  }
+
+  void clear() { build({}); }
+
+  /**
+   * @brief Jumlah entry dengan key dalam rentang [low, high]
+   *
+   */
+  size_t count(long long low, long long high) const {
+    if (low > high) return 0;
+    return countIn(main_, low, high) - countIn(removed_, low, high) +
+           countIn(delta_, low, high);
+  }
+
+  /**
+   * @brief Menelusuri entry dengan key dalam rentang [low, high] secara
+   * terurut
+   *
+   * @param visit Dipanggil dengan const Entry&, berhenti jika mengembalikan
+   * false
+   */
+  template <typename Visitor>
+  void scan(long long low, long long high, Visitor visit) const {
+    if (low > high) return;
+
+    auto item = lowerBound(main_, low), last = upperBound(main_, high);
+    auto extra = lowerBound(delta_, low), extra_last = upperBound(delta_, high);
+    auto removed = lowerBound(removed_, low);
+    while (item != last || extra != extra_last) {
+      if (item == last || (extra != extra_last && *extra < *item)) {
+        if (!visit(*extra++)) return;
+        continue;
+      }
+
+      while (removed != removed_.end() && *removed < *item) removed++;
+      if (removed != removed_.end() && *removed == *item) {
+        item++;
+        continue;
+      }
+      if (!visit(*item++)) return;
+    }
+  }
+
+  size_t size() const { return main_.size() - removed_.size() + delta_.size(); }
+
+ private:
+  static constexpr size_t kMinDelta = 64; /**< Ukuran delta minimal */
+
+  std::vector<Entry> main_;    /**< Array utama terurut */
+  std::vector<Entry> delta_;   /**< Entry baru yang belum digabung */
+  std::vector<Entry> removed_; /**< Entry array utama yang sudah dihapus */
+
+  using Iterator = std::vector<Entry>::const_iterator;
+
+  static Iterator lowerBound(const std::vector<Entry>& entries,
+                             long long key) {
+    return std::lower_bound(entries.begin(), entries.end(), Entry{key, 0});
+  }
+
+  static Iterator upperBound(const std::vector<Entry>& entries,
+                             long long key) {
+    return std::upper_bound(entries.begin(), entries.end(),
+                            Entry{key, SIZE_MAX});
+  }
+
+  static size_t countIn(const std::vector<Entry>& entries, long long low,
+                        long long high) {
+    return static_cast<size_t>(upperBound(entries, high) -
+                               lowerBound(entries, low));
+  }
+
+  size_t mergeThreshold() const {
+    return std::max(kMinDelta, static_cast<size_t>(std::sqrt(main_.size())));
+  }
+
+  /**
+   * @brief Menggabungkan delta dan tombstone ke array utama
+   *
+   */
+  void merge() {
+    std::vector<Entry> merged;
+    merged.reserve(size());
+    scan(LLONG_MIN, LLONG_MAX, [&merged](const Entry& entry) {
+      merged.push_back(entry);
+      return true;
+    });
+    main_ = std::move(merged);
+    delta_.clear();
+    removed_.clear();
+  }
+};
+#pragma endregion
+
+#pragma region Compressed Bitmap (Roaring)
+/**
+ * @class RoaringBitmap
+ * @brief Bitmap terkompresi untuk himpunan ID (gaya Roaring)
+ *
+ * Nilai dibagi ke container berdasarkan 16 bit atas. Container yang jarang
+ * (<= 4096 nilai) menyimpan 16 bit bawah dalam array terurut, container yang
+ * padat memakai bitmap 65536 bit (1024 word). AND, OR, dan AND NOT berjalan
+ * per container: bitmap dengan bitmap cukup operasi bit per word (mudah
+ * divektorisasi oleh compiler), array memakai merge atau pengecekan bit.
+ * Jumlah anggota setiap container disimpan sehingga cardinality() O(jumlah
+ * container).
+ */
+class RoaringBitmap {
+ public:
+  void add(uint64_t value) {
+    Container& container = containerFor(value >> 16);
+    container.add(static_cast<uint16_t>(value));
+  }
+
+  void remove(uint64_t value) {
+    auto position = find(value >> 16);
+    if (position == containers_.end() || position->key != value >> 16) return;
+
+    position->container.remove(static_cast<uint16_t>(value));
+    if (position->container.cardinality == 0) containers_.erase(position);
+  }
+
+  bool contains(uint64_t value) const {
+    auto position = find(value >> 16);
+    return position != containers_.end() && position->key == value >> 16 &&
+           position->container.contains(static_cast<uint16_t>(value));
+  }
+
+  size_t cardinality() const {
+    size_t total = 0;
+    for (const Entry& entry : containers_) total += entry.container.cardinality;
+    return total;
+  }
+
+  bool empty() const { return containers_.empty(); }
+  void clear() { containers_.clear(); }
+
+  /**
+   * @brief Irisan (AND) dengan bitmap lain
+   *
+   */
+  RoaringBitmap& operator&=(const RoaringBitmap& other) {
+    std::vector<Entry> result;
+    auto mine = containers_.begin();
+    auto theirs = other.containers_.begin();
+    while (mine != containers_.end() && theirs != other.containers_.end()) {
+      if (mine->key < theirs->key) {
+        mine++;
+      } else if (theirs->key < mine->key) {
+        theirs++;
+      } else {
+        Container merged = Container::intersect(mine->container,
+                                                theirs->container);
+        if (merged.cardinality) {
+          result.push_back({mine->key, std::move(merged)});
+        }
+        mine++;
+        theirs++;
+      }
+    }
+    containers_ = std::move(result);
+    return *this;
+  }
+
+  /**
+   * @brief Gabungan (OR) dengan bitmap lain
+   *
+   */
+  RoaringBitmap& operator|=(const RoaringBitmap& other) {
+    std::vector<Entry> result;
+    result.reserve(containers_.size() + other.containers_.size());
+    auto mine = containers_.begin();
+    auto theirs = other.containers_.begin();
+    while (mine != containers_.end() || theirs != other.containers_.end()) {
+      if (theirs == other.containers_.end() ||
+          (mine != containers_.end() && mine->key < theirs->key)) {
+        result.push_back(std::move(*mine++));
+      } else if (mine == containers_.end() || theirs->key < mine->key) {
+        result.push_back(*theirs++);
+      } else {
+        result.push_back(
+            {mine->key, Container::unite(mine->container, theirs->container)});
+        mine++;
+        theirs++;
+      }
+    }
+    containers_ = std::move(result);
+    return *this;
+  }
+
+  /**
+   * @brief Selisih (AND NOT) dengan bitmap lain
+   *
+   */
+  RoaringBitmap& operator-=(const RoaringBitmap& other) {
+    std::vector<Entry> result;
+    auto theirs = other.containers_.begin();
+    for (Entry& mine : containers_) {
+      while (theirs != other.containers_.end() && theirs->key < mine.key) {
+        theirs++;
+      }
+      if (theirs == other.containers_.end() || theirs->key != mine.key) {
+        result.push_back(std::move(mine));
+        continue;
+      }
+
+      Container rest = Container::subtract(mine.container, theirs->container);
+      if (rest.cardinality) result.push_back({mine.key, std::move(rest)});
+    }
+    containers_ = std::move(result);
+    return *this;
+  }
+
+  /**
+   * @brief Jumlah anggota irisan dua bitmap tanpa membentuk hasilnya
+   *
+   */
+  static size_t andCardinality(const RoaringBitmap& a, const RoaringBitmap& b) {
+    size_t total = 0;
+    auto left = a.containers_.begin();
+    auto right = b.containers_.begin();
+    while (left != a.containers_.end() && right != b.containers_.end()) {
+      if (left->key < right->key) {
+        left++;
+      } else if (right->key < left->key) {
+        right++;
+      } else {
+        total += Container::intersectCount(left->container, right->container);
+        left++;
+        right++;
+      }
+    }
+    return total;
+  }
+
+  /**
+   * @brief Menelusuri anggota dari yang terkecil
+   *
+   * @param visit Dipanggil dengan uint64_t, berhenti jika mengembalikan false
+   */
+  template <typename Visitor>
+  void forEach(Visitor visit) const {
+    for (const Entry& entry : containers_) {
+      uint64_t base = entry.key << 16;
+      const Container& container = entry.container;
+      if (!container.isBitmap()) {
+        for (uint16_t low : container.values) {
+          if (!visit(base | low)) return;
+        }
+        continue;
+      }
+
+      for (size_t word = 0; word < Container::kWords; word++) {
+        for (uint64_t bits = container.bits[word]; bits; bits &= bits - 1) {
+          uint64_t bit = static_cast<uint64_t>(__builtin_ctzll(bits));
+          if (!visit(base | (word << 6) | bit)) return;
+        }
+      }
+    }
+  }
+
+  /**
+   * @return size_t Perkiraan memori yang dipakai (byte)
+   */
+  size_t memoryUsage() const {
+    size_t total = containers_.capacity() * sizeof(Entry);
+    for (const Entry& entry : containers_) {
+      total += entry.container.values.capacity() * sizeof(uint16_t) +
+               entry.container.bits.capacity() * sizeof(uint64_t);
+    }
+    return total;
+  }
+
+ private:
+  /**
+   * @brief Anggota dengan 16 bit atas yang sama, dalam bentuk array atau
+   * bitmap
+   *
+   */
+  struct Container {
+    static constexpr size_t kArrayMax = 4096; /**< Batas container array */
+    static constexpr size_t kWords = 1024;    /**< 65536 bit */
+
+    std::vector<uint16_t> values; /**< Anggota terurut (bentuk array) */
+    std::vector<uint64_t> bits;   /**< Bit anggota (bentuk bitmap) */
+    size_t cardinality{0};        /**< Jumlah anggota */
+
+    bool isBitmap() const { return !bits.empty(); }
+
+    bool contains(uint16_t low) const {
+      if (isBitmap()) return (bits[low >> 6] >> (low & 63)) & 1;
+      return std::binary_search(values.begin(), values.end(), low);
+    }
+
+    void add(uint16_t low) {
+      if (isBitmap()) {
+        uint64_t mask = uint64_t{1} << (low & 63);
+        if (!(bits[low >> 6] & mask)) cardinality++;
+        bits[low >> 6] |= mask;
+        return;
+      }
+
+      // ID baru biasanya paling besar, cukup ditambahkan di akhir
+      auto position = values.empty() || values.back() < low
+                          ? values.end()
+                          : std::lower_bound(values.begin(), values.end(), low);
+      if (position != values.end() && *position == low) return;
+      values.insert(position, low);
+      cardinality++;
+      if (cardinality > kArrayMax) toBitmap();
+    }
+
+    void remove(uint16_t low) {
+      if (isBitmap()) {
+        uint64_t mask = uint64_t{1} << (low & 63);
+        if (bits[low >> 6] & mask) cardinality--;
+        bits[low >> 6] &= ~mask;
+        if (cardinality <= kArrayMax) toArray();
+        return;
+      }
+
+      auto position = std::lower_bound(values.begin(), values.end(), low);
+      if (position == values.end() || *position != low) return;
+      values.erase(position);
+      cardinality--;
+    }
+
+    void toBitmap() {
+      bits.assign(kWords, 0);
+      for (uint16_t low : values) bits[low >> 6] |= uint64_t{1} << (low & 63);
+      values = std::vector<uint16_t>();
+    }
+
+    void toArray() {
+      values.clear();
+      values.reserve(cardinality);
+      for (size_t word = 0; word < kWords; word++) {
+        for (uint64_t set = bits[word]; set; set &= set - 1) {
+          values.push_back(
+              static_cast<uint16_t>((word << 6) | __builtin_ctzll(set)));
+        }
+      }
+      bits = std::vector<uint64_t>();
+    }
+
+    /**
+     * @brief Menyesuaikan bentuk container dengan jumlah anggotanya
+     *
+     */
+    void normalize() {
+      if (isBitmap() && cardinality <= kArrayMax) toArray();
+      if (!isBitmap() && cardinality > kArrayMax) toBitmap();
+    }
+
+    static Container fromWords(std::vector<uint64_t> words) {
+      Container result;
+      for (uint64_t word : words) {
+        result.cardinality += static_cast<size_t>(__builtin_popcountll(word));
+      }
+      result.bits = std::move(words);
+      result.normalize();
+      return result;
+    }
+
+    static Container intersect(const Container& a, const Container& b) {
+      if (a.isBitmap() && b.isBitmap()) {
+        std::vector<uint64_t> words(kWords);
+        for (size_t i = 0; i < kWords; i++) words[i] = a.bits[i] & b.bits[i];
+        return fromWords(std::move(words));
+      }
+
+      Container result;
+      if (a.isBitmap() || b.isBitmap()) {
+        const Container& array = a.isBitmap() ? b : a;
+        const Container& bitmap = a.isBitmap() ? a : b;
+        for (uint16_t low : array.values) {
+          if (bitmap.contains(low)) result.values.push_back(low);
+        }
+      } else {
+        std::set_intersection(a.values.begin(), a.values.end(),
+                              b.values.begin(), b.values.end(),
+                              std::back_inserter(result.values));
+      }
+      result.cardinality = result.values.size();
+      return result;
+    }
+
+    static Container unite(const Container& a, const Container& b) {
+      if (!a.isBitmap() && !b.isBitmap()) {
+        Container result;
+        std::set_union(a.values.begin(), a.values.end(), b.values.begin(),
+                       b.values.end(), std::back_inserter(result.values));
+        result.cardinality = result.values.size();
+        result.normalize();
+        return result;
+      }
+
+      std::vector<uint64_t> words = a.isBitmap() ? a.bits : b.bits;
+      const Container& other = a.isBitmap() ? b : a;
+      if (other.isBitmap()) {
+        for (size_t i = 0; i < kWords; i++) words[i] |= other.bits[i];
+      } else {
+        for (uint16_t low : other.values) {
+          words[low >> 6] |= uint64_t{1} << (low & 63);
+        }
+      }
+      return fromWords(std::move(words));
+    }
+
+    static Container subtract(const Container& a, const Container& b) {
+      if (a.isBitmap()) {
+        std::vector<uint64_t> words = a.bits;
+        if (b.isBitmap()) {
+          for (size_t i = 0; i < kWords; i++) words[i] &= ~b.bits[i];
+        } else {
+          for (uint16_t low : b.values) {
+            words[low >> 6] &= ~(uint64_t{1} << (low & 63));
+          }
+        }
+        return fromWords(std::move(words));
+      }
+
+      Container result;
+      if (b.isBitmap()) {
+        for (uint16_t low : a.values) {
+          if (!b.contains(low)) result.values.push_back(low);
+        }
+      } else {
+        std::set_difference(a.values.begin(), a.values.end(),
+                            b.values.begin(), b.values.end(),
+                            std::back_inserter(result.values));
+      }
+      result.cardinality = result.values.size();
+      return result;
+    }
+
+    static size_t intersectCount(const Container& a, const Container& b) {
+      size_t total = 0;
+      if (a.isBitmap() && b.isBitmap()) {
+        for (size_t i = 0; i < kWords; i++) {
+          total +=
+              static_cast<size_t>(__builtin_popcountll(a.bits[i] & b.bits[i]));
+        }
+      } else if (a.isBitmap() || b.isBitmap()) {
+        const Container& array = a.isBitmap() ? b : a;
+        const Container& bitmap = a.isBitmap() ? a : b;
+        for (uint16_t low : array.values) total += bitmap.contains(low);
+      } else {
+        auto left = a.values.begin(), right = b.values.begin();
+        while (left != a.values.end() && right != b.values.end()) {
+          if (*left < *right) {
+            left++;
+          } else if (*right < *left) {
+            right++;
+          } else {
+            total++;
+            left++;
+            right++;
+          }
+        }
+      }
+      return total;
+    }
+  };
+
+  /**
+   * @brief Container beserta 16 bit atas anggotanya
+   *
+   */
+  struct Entry {
+    uint64_t key;
+    Container container;
+  };
+
+  std::vector<Entry> containers_; /**< Terurut berdasarkan key */
+
+  std::vector<Entry>::const_iterator find(uint64_t key) const {
+    return std::lower_bound(
+        containers_.begin(), containers_.end(), key,
+        [](const Entry& entry, uint64_t target) { return entry.key < target; });
+  }
+
+  std::vector<Entry>::iterator find(uint64_t key) {
+    return std::lower_bound(
+        containers_.begin(), containers_.end(), key,
+        [](const Entry& entry, uint64_t target) { return entry.key < target; });
+  }
+
+  Container& containerFor(uint64_t key) {
+    if (!containers_.empty() && containers_.back().key == key) {
+      return containers_.back().container;
+    }
+
+    auto position = find(key);
+    if (position == containers_.end() || position->key != key) {
+      position = containers_.insert(position, Entry{key, Container()});
+    }
+    return position->container;
+  }
+};
+#pragma endregion
+
+#pragma region Thread Pool
+/**
+ * @class TaskPool
+ * @brief Thread pool sederhana untuk sekumpulan pekerjaan yang ditunggu
+ * bersama
+ *
+ * Task boleh menambahkan task lain. wait() menunggu hingga seluruh task,
+ * termasuk yang ditambahkan belakangan, selesai dijalankan.
+ */
+class TaskPool {
+ public:
+  /**
+   * @param threads Jumlah thread pekerja (0 = jumlah core)
+   */
+  explicit TaskPool(size_t threads = 0) {
+    if (threads == 0) {
+      threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+
+    workers_.reserve(threads);
+    for (size_t i = 0; i < threads; i++) {
+      workers_.emplace_back(&TaskPool::work, this);
+    }
+  }
+
+  TaskPool(const TaskPool&) = delete;
+  TaskPool& operator=(const TaskPool&) = delete;
+
+  ~TaskPool() {
+    wait();
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      stopping_ = true;
+    }
+    ready_.notify_all();
+    for (std::thread& worker : workers_) worker.join();
+  }
+
+  /**
+   * @brief Menambahkan task ke antrian
+   *
+   * @param task Pekerjaan yang akan dijalankan salah satu thread pekerja
+   */
+  void submit(std::function<void()> task) {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      tasks_.push(std::move(task));
+      pending_++;
+    }
+    ready_.notify_one();
+  }
+
+  /**
+   * @brief Menunggu hingga seluruh task selesai
+   *
+   */
+  void wait() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    done_.wait(lock, [this] { return pending_ == 0; });
+  }
+
+ private:
+  std::mutex mutex_;                       /**< Pelindung antrian task */
+  std::condition_variable ready_;          /**< Sinyal ada task baru */
+  std::condition_variable done_;           /**< Sinyal seluruh task selesai */
+  std::queue<std::function<void()>> tasks_; /**< Task yang belum dijalankan */
+  size_t pending_{0};      /**< Task yang belum selesai (antri + berjalan) */
+  bool stopping_{false};   /**< Pool sedang dihentikan */
+  std::vector<std::thread> workers_; /**< Thread pekerja */
+
+  void work() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (true) {
+      ready_.wait(lock, [this] { return stopping_ || !tasks_.empty(); });
+      if (tasks_.empty()) return;
+
+      std::function<void()> task = std::move(tasks_.front());
+      tasks_.pop();
+      lock.unlock();
+      task();
+      lock.lock();
+
+      if (--pending_ == 0) done_.notify_all();
+    }
+  }
+};
+#pragma endregion
+
+#pragma region FileHandling
+/**
+ * @class Writer
+ * @brief Tujuan serialisasi data biner (file, buffer memori, dll)
+ *
+ * Objek yang dapat disimpan menerima Writer secara eksplisit pada
+ * serialize(Writer&), sehingga tidak ada state global dan beberapa
+ * penyimpanan dapat berjalan bersamaan.
+ */
+class Writer {
+ public:
+  virtual ~Writer() = default;
+
+  /**
+   * @brief Menulis sejumlah byte
+   *
+   * @return true jika seluruh byte berhasil ditulis
+   */
+  virtual bool writeBytes(const void* data, size_t size) = 0;
+
+  /**
+   * @brief Menulis data.
+   *
+   * @tparam T Tipe data yang akan ditulis.
+   * @param data Data yang ingin disimpan.
+   * @return true Jika penulisan berhasil.
+   */
+  template <typename T>
+  bool write(const T& data) {
+    static_assert(std::is_trivially_copyable<T>::value,
+                  "Hanya tipe data yang dapat disalin per byte!");
+    return writeBytes(&data, sizeof(T));
+  }
+
+  /**
+   * @brief Menulis string (char array).
+   *
+   * @param str String yang ingin ditulis.
+   * @param length Panjang string yang akan ditulis.
+   * @return true Jika seluruh karakter berhasil ditulis.
+   */
+  bool write(const char* str, size_t length) { return writeBytes(str, length); }
+};
+
+/**
+ * @class Reader
+ * @brief Sumber deserialisasi data biner (file, buffer memori, mmap, dll)
+ *
+ */
+class Reader {
+ public:
+  virtual ~Reader() = default;
+
+  /**
+   * @brief Membaca sejumlah byte
+   *
+   * @return true jika seluruh byte berhasil dibaca
+   */
+  virtual bool readBytes(void* data, size_t size) = 0;
+
+  /**
+   * @brief Membaca data.
+   *
+   * @tparam T Tipe data yang ingin dibaca.
+   * @param data Referensi variabel tempat menyimpan hasil pembacaan.
+   * @param length Jumlah elemen yang ingin dibaca (default = 1).
+   * @return true Jika jumlah data yang dibaca sesuai dengan yang diminta.
+   */
+  template <typename T>
+  bool read(T& data, size_t length = 1) {
+    static_assert(std::is_trivially_copyable<T>::value,
+                  "Hanya tipe data yang dapat disalin per byte!");
+    return readBytes(&data, sizeof(T) * length);
+  }
+
+  /**
+   * @brief Membaca string (char array).
+   *
+   * @param str Buffer tempat menyimpan hasil pembacaan.
+   * @param length Panjang karakter yang akan dibaca.
+   * @return true Jika seluruh karakter berhasil dibaca.
+   */
+  bool read(char* str, size_t length) { return readBytes(str, length); }
+};
+
+/**
+ * @class FileWriter
+ * @brief Writer yang menulis ke file biner
+ *
+ */
+class FileWriter : public Writer {
+ public:
+  explicit FileWriter(const std::string& filename)
+      : file_(fopen(filename.c_str(), "wb")) {}
+  FileWriter(const FileWriter&) = delete;
+  FileWriter& operator=(const FileWriter&) = delete;
+  ~FileWriter() override { close(); }
+
+  bool isOpen() const { return file_ != nullptr; }
+
+  bool writeBytes(const void* data, size_t size) override {
+    RAIVFY_COUNT(kBytesWritten, size);
+    if (size == 0) return file_ != nullptr;
+    return file_ && fwrite(data, 1, size, file_) == size;
+  }
+
+  /**
+   * @brief Memastikan seluruh data yang sudah ditulis sampai di disk
+   *
+   * @return true jika sinkronisasi berhasil
+   */
+  bool sync() {
+    if (!file_ || fflush(file_) != 0) return false;
+#ifdef __WIN32__
+    return true;
+#else
+    return fsync(fileno(file_)) == 0;
+#endif
+  }
+
+  /**
+   * @brief Menutup file dan memastikan seluruh data sudah tertulis
+   *
+   * @return true jika penutupan berhasil
+   */
+  bool close() {
+    if (!file_) return true;
+    bool ok = fclose(file_) == 0;
+    file_ = nullptr;
+    return ok;
+  }
+
+ private:
+  FILE* file_; /**< File tujuan */
+};
+
+/**
+ * @class FileReader
+ * @brief Reader yang membaca file biner secara berurutan
+ *
+ */
+class FileReader : public Reader {
+ public:
+  explicit FileReader(const std::string& filename)
+      : file_(fopen(filename.c_str(), "rb")) {}
+  FileReader(const FileReader&) = delete;
+  FileReader& operator=(const FileReader&) = delete;
+  ~FileReader() override {
+    if (file_) fclose(file_);
+  }
+
+  bool isOpen() const { return file_ != nullptr; }
+
+  bool readBytes(void* data, size_t size) override {
+    RAIVFY_COUNT(kBytesRead, size);
+    return file_ && fread(data, 1, size, file_) == size;
+  }
+
+ private:
+  FILE* file_; /**< File sumber */
+};
+
+/**
+ * @class MemoryWriter
+ * @brief Writer yang menulis ke buffer di memori
+ *
+ * Berguna untuk mengambil snapshot data tanpa menyentuh disk, misalnya
+ * sebelum ditulis oleh thread lain.
+ */
+class MemoryWriter : public Writer {
+ public:
+  bool writeBytes(const void* data, size_t size) override {
+    const char* bytes = static_cast<const char*>(data);
+    buffer_.insert(buffer_.end(), bytes, bytes + size);
+    return true;
+  }
+
+  const std::vector<char>& buffer() const { return buffer_; }
+  std::vector<char> release() { return std::move(buffer_); }
+  void reserve(size_t size) { buffer_.reserve(size); }
+
+ private:
+  std::vector<char> buffer_; /**< Data yang sudah ditulis */
+};
+
+/**
+ * @class MemoryReader
+ * @brief Reader yang membaca dari buffer di memori (tidak menyalin buffer)
+ *
+ */
+class MemoryReader : public Reader {
+ public:
+  MemoryReader(const char* data, size_t size) : data_(data), size_(size) {}
+  explicit MemoryReader(const std::vector<char>& buffer)
+      : MemoryReader(buffer.data(), buffer.size()) {}
+
+  bool readBytes(void* data, size_t size) override {
+    if (size_ - offset_ < size) return false;
+    std::memcpy(data, data_ + offset_, size);
+    offset_ += size;
+    return true;
+  }
+
+ private:
+  const char* data_;  /**< Awal buffer */
+  size_t size_;       /**< Ukuran buffer */
+  size_t offset_{0};  /**< Posisi baca */
+};
+
+/**
+ * @class BufferWriter
+ * @brief Writer yang menulis ke buffer berukuran tetap milik pemanggil
+ *
+ */
+class BufferWriter : public Writer {
+ public:
+  BufferWriter(char* data, size_t size) : data_(data), size_(size) {}
+
+  bool writeBytes(const void* data, size_t size) override {
+    if (size_ - offset_ < size) return false;
+    std::memcpy(data_ + offset_, data, size);
+    offset_ += size;
+    return true;
+  }
+
+ private:
+  char* data_;       /**< Awal buffer */
+  size_t size_;      /**< Ukuran buffer */
+  size_t offset_{0}; /**< Posisi tulis */
+};
+
+/**
+ * @class MappedReader
+ * @brief Reader yang membaca file melalui memory map
+ *
+ * Seluruh file dipetakan sekali, pembacaan record cukup menyalin dari memori
+ * tanpa system call. Jika mmap tidak tersedia, isi file dibaca sekaligus ke
+ * buffer.
+ */
+class MappedReader : public Reader {
+ public:
+  explicit MappedReader(const std::string& filename) {
+#ifndef __WIN32__
+    int fd = ::open(filename.c_str(), O_RDONLY);
+    if (fd < 0) return;
+
+    struct stat info {};
+    if (fstat(fd, &info) == 0) {
+      open_ = true;
+      size_ = static_cast<size_t>(info.st_size);
+      if (size_ > 0) {
+        void* mapped = mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (mapped != MAP_FAILED) {
+          data_ = static_cast<const char*>(mapped);
+          mapped_ = true;
+        } else {
+          open_ = false;
+        }
+      }
+    }
+    ::close(fd);
+#else
+    FILE* file = fopen(filename.c_str(), "rb");
+    if (!file) return;
+
+    fseek(file, 0, SEEK_END);
+    long file_size = ftell(file);
+    fseek(file, 0, SEEK_SET);
+    fallback_.resize(file_size > 0 ? static_cast<size_t>(file_size) : 0);
+    size_ = fread(fallback_.data(), 1, fallback_.size(), file);
+    data_ = fallback_.data();
+    open_ = true;
+    fclose(file);
+#endif
+  }
+
+  MappedReader(const MappedReader&) = delete;
+  MappedReader& operator=(const MappedReader&) = delete;
+
+  ~MappedReader() override {
+#ifndef __WIN32__
+    if (mapped_) munmap(const_cast<char*>(data_), size_);
+#endif
+  }
+
+  bool isOpen() const { return open_; }
+
+  bool readBytes(void* data, size_t size) override {
+    if (size_ - offset_ < size) return false;
+    RAIVFY_COUNT(kBytesRead, size);
+    std::memcpy(data, data_ + offset_, size);
+    offset_ += size;
+    return true;
+  }
+
+ private:
+  const char* data_{nullptr}; /**< Awal isi file */
+  size_t size_{0};            /**< Ukuran file */
+  size_t offset_{0};          /**< Posisi baca */
+  bool open_{false};          /**< File berhasil dibuka */
+  bool mapped_{false};        /**< data_ berasal dari mmap */
+  std::vector<char> fallback_; /**< Isi file jika mmap tidak tersedia */
+};
+
+/**
+ * @class FileManager
+ * @brief Kelas berisi static method untuk melakukan operasi penyimpanan dan
+ * pembacaan data dari file
+ *
+ * Penyimpanan dan pembacaan secara keseluruhan dilakukan untuk binary file.
+ * Setiap operasi memakai Writer / Reader miliknya sendiri, sehingga beberapa
+ * file dapat dimuat atau disimpan bersamaan dari thread yang berbeda. Versi
+ * yang menerima Writer / Reader dapat dipakai untuk buffer memori.
+ */
+class FileManager {
+ public:
+  static constexpr const char* kDatabase{
+      "DatabaseLagu.dat"}; /**< Nama file default untuk database lagu */
+  static constexpr const char* kPlaylist{
+      "DatabasePlaylist.dat"}; /**< Nama file default untuk database playlist */
+
+  /**
+   * @brief Menyimpan data (ArrayList, LinkedList, atau IndexedList) ke file
+   * biner
+   *
+   * @tparam Container Tipe kontainer, elemennya harus memiliki method
+   * serialize(Writer&)
+   * @param filename Nama file tujuan penyimpanan (termasuk ekstensi)
+   * @param data Kontainer berisi elemen yang ingin disimpan
+   * @return true jika semua elemen berhasil disimpan
+   * @return false jika terjadi error saat penulisan atau serialisasi
+   */
+  template <typename Container>
+  static bool save(const std::string& filename, const Container& data) {
+    RAIVFY_TIMED(kSave);
+    FileWriter writer(filename);
+
+    if (!writer.isOpen()) {
+      std::cerr << "Tidak dapat membuka file: " << Text::bold(filename)
+                << "!\n";
+      return false;
+    }
+
+    return save(writer, data) && writer.close();
+  }
+
+  /**
+   * @brief Membaca data dari file biner ke dalam kontainer
+   *
+   * File dibaca melalui memory map.
+   *
+   * @tparam Container Tipe kontainer, elemennya harus memiliki method
+   * deserialize(Reader&)
+   * @param filename Nama file sumber data (termasuk ekstensi)
+   * @param data Kontainer tujuan untuk menyimpan hasil pembacaan
+   * @return true jika file berhasil dibuka dan dibaca
+   * @return false jika terjadi error saat pembukaan file
+   */
+  template <typename Container>
+  static bool load(const std::string& filename, Container& data) {
+    RAIVFY_TIMED(kLoad);
+    MappedReader reader(filename);
+
+    if (!reader.isOpen()) {
+      clearContainer(data);
+      std::cerr << "Tidak dapat membuka file: " << Text::bold(filename)
+                << "!\n";
+      return false;
+    }
+
+    load(reader, data);
+    return true;
+  }
+
+  /**
+   * @brief Menyimpan data bertipe ArrayList ke Writer
+   *
+   * @tparam T Tipe data dalam ArrayList, harus memiliki method
+   * serialize(Writer&)
+   * @param writer Tujuan penyimpanan
+   * @param data ArrayList berisi elemen yang ingin disimpan
+   * @return true jika semua elemen berhasil disimpan
+   */
+  template <typename T>
+  static bool save(Writer& writer, const ArrayList<T>& data) {
+    RAIVFY_TIMED(kSave);
+    for (size_t i = 0; i < data.size(); i++) {
+      if (!data.arr[i].serialize(writer)) return false;
+    }
+    return true;
+  }
+
+  /**
+   * @brief Menyimpan data bertipe LinkedList ke Writer
+   *
+   * @tparam T tipe elemen dalma linked list, harus memiliki serialize(Writer&)
+   * @tparam Allocator Policy alokasi node milik linked list
+   */
+  template <typename T, typename Allocator>
+  static bool save(Writer& writer, const LinkedList<T, Allocator>& data) {
+    RAIVFY_TIMED(kSave);
+    for (Node<T>* node = data.head(); node; node = node->next) {
+      if (!node->data.serialize(writer)) return false;
+    }
+    return true;
+  }
+
+  /**
+   * @brief Menyimpan data bertipe IndexedList ke Writer
+   *
+   * @tparam T tipe elemen dalam list, harus memiliki serialize(Writer&)
+   * @tparam Allocator Policy alokasi node milik list
+   */
+  template <typename T, typename Allocator>
+  static bool save(Writer& writer, const IndexedList<T, Allocator>& data) {
+    RAIVFY_TIMED(kSave);
+    for (auto* node = data.head(); node; node = node->next) {
+      if (!node->data.serialize(writer)) return false;
+    }
+    return true;
+  }
+
+  /**
+   * @brief Membaca seluruh record dari Reader ke dalam ArrayList
+   *
+   * ArrayList dikosongkan lebih dulu untuk menghindari duplikasi.
+   *
+   * @tparam T Tipe data yang akan dibaca, harus memiliki method
+   * deserialize(Reader&)
+   */
+  template <typename T>
+  static void load(Reader& reader, ArrayList<T>& data) {
+    RAIVFY_TIMED(kLoad);
+    data.clear();
+    while (true) {
+      T x;
+      if (!x.deserialize(reader)) break;
+      data.add(x);
+    }
+  }
+
+  /**
+   * @brief Membaca seluruh record dari Reader ke dalam LinkedList.
+   *
+   * @tparam T Tipe data yang akan dimasukkan ke dalam list.
+   * @tparam Allocator Policy alokasi node milik linked list.
+   */
+  template <typename T, typename Allocator>
+  static void load(Reader& reader, LinkedList<T, Allocator>& data) {
+    RAIVFY_TIMED(kLoad);
+    while (true) {
+      T x;
+      if (!x.deserialize(reader)) break;
+      data.push(x);
+    }
+  }
+
+  /**
+   * @brief Membaca seluruh record dari Reader ke dalam IndexedList.
+   *
+   * @tparam T Tipe data yang akan dimasukkan ke dalam list.
+   * @tparam Allocator Policy alokasi node milik list.
+   */
+  template <typename T, typename Allocator>
+  static void load(Reader& reader, IndexedList<T, Allocator>& data) {
+    RAIVFY_TIMED(kLoad);
+    while (true) {
+      T x;
+      if (!x.deserialize(reader)) break;
+      data.push(x);
+    }
+  }
+
+  /**
+   * @brief Menghitung jumlah record dalam file tanpa melakukan deserialisasi
+   *
+   * Digunakan untuk mengetahui isi file (misalnya jumlah lagu dalam playlist)
+   * cukup dari ukuran file, tanpa harus memuat seluruh isinya ke memori.
+   *
+   * @param filename Nama file sumber data (termasuk ekstensi)
+   * @param record_size Ukuran satu record dalam byte
+   * @return size_t Jumlah record utuh dalam file (0 jika file tidak ada)
+   */
+  static size_t countRecords(const std::string& filename, size_t record_size) {
+    FILE* file = fopen(filename.c_str(), "rb");
+    if (!file) return 0;
+
+    fseek(file, 0, SEEK_END);
+    long file_size = ftell(file);
+    fclose(file);
+
+    return file_size > 0 ? static_cast<size_t>(file_size) / record_size : 0;
+  }
+
+ private:
+  /**
+   * @brief Mengosongkan ArrayList tujuan jika file gagal dibuka
+   *
+   */
+  template <typename T>
+  static void clearContainer(ArrayList<T>& data) {
+    data.clear();
+  }
+
+  template <typename Container>
+  static void clearContainer(Container&) {}
+};
+
+/**
+ * @class PersistenceWorker
+ * @brief Thread penyimpanan yang menulis file di latar belakang
+ *
+ * Pemilik data mengirim snapshot (hasil serialisasi ke memori) setiap kali
+ * datanya berubah, sehingga menu tidak perlu menunggu disk. Snapshot untuk
+ * file yang sama dalam satu jendela waktu digabung dan hanya snapshot terakhir
+ * yang ditulis. File ditulis ke "<nama>.tmp", di-fsync, lalu di-rename,
+ * sehingga file lama tidak pernah tertimpa setengah jalan. File yang gagal
+ * ditulis dicatat hingga pemiliknya mengambilnya melalui takeFailure() dan
+ * mengirim snapshot ulang.
+ */
+class PersistenceWorker {
+ public:
+  static constexpr std::chrono::milliseconds kDefaultWindow{
+      1000}; /**< Jendela penggabungan penulisan default */
+
+  /**
+   * @brief Constructor, langsung menjalankan thread penyimpanan
+   *
+   * @param window Lama snapshot ditahan sebelum ditulis ke disk
+   */
+  explicit PersistenceWorker(std::chrono::milliseconds window = kDefaultWindow)
+      : window_(window), worker_([this] { run(); }) {}
+
+  PersistenceWorker(const PersistenceWorker&) = delete;
+  PersistenceWorker& operator=(const PersistenceWorker&) = delete;
+
+  /**
+   * @brief Menulis seluruh snapshot yang tersisa lalu menghentikan thread
+   *
+   */
+  ~PersistenceWorker() {
+    flush();
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      stopping_ = true;
+    }
+    wake_.notify_all();
+    worker_.join();
+  }
+
+  /**
+   * @brief Mengambil snapshot kontainer dan menjadwalkan penyimpanannya
+   *
+   * Serialisasi dilakukan di thread pemanggil (ke memori), penulisan ke disk
+   * dilakukan oleh thread penyimpanan.
+   *
+   * @tparam Container Kontainer yang didukung FileManager::save(Writer&, ...)
+   * @param filename File tujuan
+   * @param data Kontainer yang akan disimpan
+   */
+  template <typename Container>
+  void schedule(const std::string& filename, const Container& data) {
+    MemoryWriter writer;
+    FileManager::save(writer, data);
+    submit(filename, writer.release());
+  }
+
+  /**
+   * @brief Menjadwalkan penulisan isi file
+   *
+   * Jika file yang sama masih menunggu, isinya diganti dengan yang terbaru
+   * tanpa memundurkan jadwal penulisan.
+   *
+   * @param filename File tujuan
+   * @param bytes Isi file lengkap
+   */
+  void submit(const std::string& filename, std::vector<char> bytes) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto pending = pending_.find(filename);
+    if (pending != pending_.end()) {
+      pending->second.bytes = std::move(bytes);
+      coalesced_++;
+      return;
+    }
+
+    pending_.emplace(filename,
+                     PendingWrite{std::move(bytes), Clock::now() + window_});
+    wake_.notify_all();
+  }
+
+  /**
+   * @brief Membatalkan penulisan file yang belum dilakukan
+   *
+   * Dipanggil sebelum file dihapus agar tidak dibuat ulang oleh snapshot lama,
+   * atau sebelum pemilik data menulis file itu sendiri. Menunggu jika file
+   * tersebut sedang ditulis.
+   *
+   * @param filename File yang dibatalkan
+   * @return true jika ada snapshot yang batal ditulis atau gagal ditulis
+   */
+  bool cancel(const std::string& filename) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    bool cancelled = pending_.erase(filename) > 0;
+    idle_.wait(lock, [&] { return writing_ != filename; });
+    return failed_.erase(filename) > 0 || cancelled;
+  }
+
+  /**
+   * @brief Mengambil status gagal penulisan terakhir sebuah file
+   *
+   * Pemilik data yang mendapat true harus menganggap datanya belum tersimpan
+   * dan mengirim snapshot ulang.
+   *
+   * @param filename File yang dicek
+   * @return true jika penulisan terakhir file tersebut gagal
+   */
+  bool takeFailure(const std::string& filename) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return failed_.erase(filename) > 0;
+  }
+
+  /**
+   * @brief Menulis seluruh snapshot yang menunggu tanpa menunggu jendela
+   *
+   * Memblokir hingga seluruh penulisan selesai.
+   *
+   * @return true jika seluruh penulisan sejak flush sebelumnya berhasil
+   */
+  bool flush() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    flushing_++;
+    wake_.notify_all();
+    idle_.wait(lock, [this] { return pending_.empty() && writing_.empty(); });
+    flushing_--;
+
+    bool ok = failures_ == 0;
+    failures_ = 0;
+    return ok;
+  }
+
+  /**
+   * @return size_t Jumlah file yang sudah ditulis ke disk
+   */
+  size_t writes() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return writes_;
+  }
+
+  /**
+   * @return size_t Jumlah snapshot yang digantikan sebelum sempat ditulis
+   */
+  size_t coalesced() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return coalesced_;
+  }
+
+ private:
+  using Clock = std::chrono::steady_clock;
+
+  /**
+   * @brief Snapshot file yang menunggu ditulis
+   *
+   */
+  struct PendingWrite {
+    std::vector<char> bytes; /**< Isi file */
+    Clock::time_point due;   /**< Waktu paling lambat penulisan */
+  };
+
+  /**
+   * @brief Loop thread penyimpanan
+   *
+   */
+  void run() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (true) {
+      if (pending_.empty()) {
+        if (stopping_) return;
+        wake_.wait(lock);
+        continue;
+      }
+
+      auto next = std::min_element(
+          pending_.begin(), pending_.end(), [](const auto& a, const auto& b) {
+            return a.second.due < b.second.due;
+          });
+      if (flushing_ == 0 && !stopping_ && next->second.due > Clock::now()) {
+        wake_.wait_until(lock, next->second.due);
+        continue;
+      }
+
+      writing_ = next->first;
+      std::vector<char> bytes = std::move(next->second.bytes);
+      pending_.erase(next);
+
+      lock.unlock();
+      bool ok = writeFile(writing_, bytes);
+      lock.lock();
+
+      writes_++;
+      if (ok) {
+        failed_.erase(writing_);
+      } else {
+        failures_++;
+        failed_.insert(writing_);
+      }
+      writing_.clear();
+      idle_.notify_all();
+    }
+  }
+
+  /**
+   * @brief Menulis isi file melalui file sementara lalu rename
+   *
+   * File sementara di-fsync sebelum rename, sehingga file yang tampil dengan
+   * nama aslinya selalu berisi snapshot yang lengkap.
+   */
+  static bool writeFile(const std::string& filename,
+                        const std::vector<char>& bytes) {
+    std::string temp = filename + ".tmp";
+    FileWriter writer(temp);
+    bool ok = writer.isOpen() &&
+              writer.writeBytes(bytes.data(), bytes.size()) &&
+              writer.sync() && writer.close();
+
+#ifdef __WIN32__
+    if (ok) std::remove(filename.c_str());
+#endif
+    if (!ok || std::rename(temp.c_str(), filename.c_str()) != 0) {
+      std::cerr << "Gagal menyimpan file: " << Text::bold(filename) << "!\n";
+      std::remove(temp.c_str());
+      return false;
+    }
+    return true;
+  }
+
+  const std::chrono::milliseconds window_; /**< Jendela penggabungan */
+  mutable std::mutex mutex_;               /**< Pelindung seluruh state */
+  std::condition_variable wake_; /**< Membangunkan thread penyimpanan */
+  std::condition_variable idle_; /**< Sinyal satu penulisan selesai */
+  std::unordered_map<std::string, PendingWrite>
+      pending_;          /**< Snapshot per file yang menunggu ditulis */
+  std::string writing_;  /**< File yang sedang ditulis */
+  size_t flushing_{0};   /**< Jumlah pemanggil flush() yang menunggu */
+  bool stopping_{false}; /**< Thread diminta berhenti */
+  size_t writes_{0};     /**< Jumlah penulisan file */
+  size_t coalesced_{0};  /**< Jumlah snapshot yang digabung */
+  size_t failures_{0};   /**< Penulisan gagal sejak flush terakhir */
+  std::unordered_set<std::string>
+      failed_;           /**< File yang penulisan terakhirnya gagal */
+  std::thread worker_;   /**< Thread penyimpanan */
+};
+
+/**
+ * @class DelimitedReader
+ * @brief Pembaca file CSV / TSV secara streaming tanpa alokasi per baris
+ *
+ * File dibaca per blok ke satu buffer. Setiap record dipecah langsung di
+ * dalam buffer menjadi std::string_view, sehingga tidak ada std::string yang
+ * dibuat per baris maupun per kolom. Pada CSV, kolom di dalam tanda kutip
+ * boleh berisi pemisah atau newline, dan "" dibaca sebagai satu tanda kutip.
+ */
+class DelimitedReader {
+ public:
+  static constexpr size_t kMaxFields = 16;         /**< Kolom maksimum */
+  static constexpr size_t kBlockSize = 1 << 20;    /**< Ukuran baca (1 MiB) */
+
+  /**
+   * @param file File sumber yang sudah dibuka (tidak ditutup oleh reader)
+   * @param delimiter Pemisah kolom (',' atau '\t')
+   */
+  DelimitedReader(FILE* file, char delimiter)
+      : file_(file), delimiter_(delimiter), buffer_(kBlockSize) {}
+
+  /**
+   * @brief Membaca record berikutnya
+   *
+   * Kolom hasil pembacaan hanya valid sampai next() dipanggil lagi.
+   *
+   * @return true jika ada record, false jika file sudah habis
+   */
+  bool next() {
+    while (true) {
+      size_t end = findRecordEnd();
+      if (end != kNotFound) {
+        split(begin_, end);
+        begin_ = end + 1;
+        return true;
+      }
+
+      if (eof_) {
+        if (begin_ == end_) return false;
+        split(begin_, end_);
+        begin_ = end_;
+        return true;
+      }
+      refill();
+    }
+  }
+
+  size_t fieldCount() const { return count_; }
+  std::string_view field(size_t index) const { return fields_[index]; }
+
+  /**
+   * @brief Mengecek apakah record terakhir memiliki lebih dari kMaxFields
+   * kolom (kolom sisanya tidak dibaca)
+   *
+   */
+  bool truncated() const { return truncated_; }
+
+ private:
+  static constexpr size_t kNotFound = static_cast<size_t>(-1);
+
+  FILE* file_;                  /**< File sumber */
+  char delimiter_;              /**< Pemisah kolom */
+  std::vector<char> buffer_;    /**< Blok data yang sedang dibaca */
+  size_t begin_{0};             /**< Awal record berikutnya di buffer */
+  size_t end_{0};               /**< Akhir data valid di buffer */
+  size_t scanned_{0};           /**< Posisi pencarian akhir record */
+  bool quoted_{false};          /**< Status kutip saat pencarian berhenti */
+  bool eof_{false};             /**< File sudah habis dibaca */
+  std::string_view fields_[kMaxFields]; /**< Kolom record terakhir */
+  size_t count_{0};             /**< Jumlah kolom record terakhir */
+  bool truncated_{false};       /**< Record terakhir melebihi kMaxFields */
+
+  /**
+   * @brief Mencari newline akhir record (di luar tanda kutip)
+   *
+   * Pencarian dilanjutkan dari posisi terakhir agar record panjang yang
+   * terpotong blok tidak dipindai ulang dari awal.
+   */
+  size_t findRecordEnd() {
+    bool csv = delimiter_ == ',';
+    size_t i = std::max(scanned_, begin_);
+    for (; i < end_; i++) {
+      char c = buffer_[i];
+      if (csv && c == '"') {
+        quoted_ = !quoted_;
+      } else if (c == '\n' && !quoted_) {
+        scanned_ = i + 1;
+        return i;
+      }
+    }
+
+    scanned_ = i;
+    return kNotFound;
+  }
+
+  /**
+   * @brief Memindahkan sisa data ke awal buffer lalu membaca blok berikutnya
+   *
+   */
+  void refill() {
+    size_t pending = end_ - begin_;
+    if (begin_ > 0) {
+      std::memmove(buffer_.data(), buffer_.data() + begin_, pending);
+      scanned_ -= begin_;
+      begin_ = 0;
+      end_ = pending;
+    }
+    if (end_ == buffer_.size()) buffer_.resize(buffer_.size() * 2);
+
+    size_t read = fread(buffer_.data() + end_, 1, buffer_.size() - end_, file_);
+    end_ += read;
+    if (read == 0) eof_ = true;
+  }
+
+  /**
+   * @brief Memecah satu record menjadi kolom, tanda kutip dibuang di tempat
+   *
+   */
+  void split(size_t begin, size_t end) {
+    if (end > begin && buffer_[end - 1] == '\r') end--;
+    bool csv = delimiter_ == ',';
+    char* data = buffer_.data();
+    count_ = 0;
+    quoted_ = false;
+    truncated_ = false;
+
+    size_t i = begin;
+    while (true) {
+      if (count_ == kMaxFields) {
+        truncated_ = true;
+        break;
+      }
+
+      size_t start = i, out = i;
+      if (csv && i < end && data[i] == '"') {
+        i++;
+        while (i < end) {
+          if (data[i] == '"') {
+            if (i + 1 < end && data[i + 1] == '"') {
+              data[out++] = '"';
+              i += 2;
+              continue;
+            }
+            i++;
+            break;
+          }
+          data[out++] = data[i++];
+        }
+        while (i < end && data[i] != delimiter_) i++;
+      } else {
+        while (i < end && data[i] != delimiter_) i++;
+        out = i;
+      }
+
+      fields_[count_++] = std::string_view(data + start, out - start);
+      if (i >= end) break;
+      i++;
+    }
+  }
+};
+#pragma endregion
+
+#pragma region Storage Engine (B+-Tree)
+/**
+ * @class PageFile
+ * @brief File berisi halaman berukuran tetap
+ *
+ * Halaman 0 berisi header (magic, jumlah halaman, root setiap tree, dan
+ * jumlah record), halaman lain berisi node B+-tree. Halaman baru selalu
+ * ditambahkan di akhir file.
+ *
+ * Perubahan bersifat atomik per sync() melalui rollback journal
+ * ("<nama>-journal"): sebelum halaman yang sudah ada saat commit terakhir
+ * ditimpa, isi aslinya disalin ke journal dan journal di-fsync. sync()
+ * melakukan fsync halaman data, lalu menulis header dan fsync lagi, lalu
+ * menghapus journal sebagai titik commit. Jika aplikasi berhenti sebelum
+ * commit, open() mengembalikan isi halaman dari journal.
+ */
+class PageFile {
+ public:
+  using PageId = uint64_t;
+  static constexpr size_t kPageSize = 4096; /**< Ukuran satu halaman */
+  static constexpr size_t kMaxRoots = 4;    /**< Jumlah tree dalam satu file */
+  static constexpr PageId kNoPage = 0; /**< Penanda tidak ada halaman */
+
+  /**
+   * @brief Isi halaman 0
+   *
+   */
+  struct Header {
+    char magic[8];            /**< Penanda file halaman RAiVFY */
+    uint32_t version;         /**< Versi format */
+    uint32_t page_size;       /**< Ukuran halaman saat file dibuat */
+    uint64_t page_count;      /**< Jumlah halaman termasuk header */
+    uint64_t records;         /**< Jumlah record (diisi pemilik file) */
+    PageId roots[kMaxRoots];  /**< Root setiap tree */
+    uint64_t salt;            /**< Acak per file, mengikat journal ke file */
+  };
+
+  PageFile() = default;
+  PageFile(const PageFile&) = delete;
+  PageFile& operator=(const PageFile&) = delete;
+  ~PageFile() { close(); }
+
+  /**
+   * @brief Membuka file halaman, membuat file baru jika belum ada
+   *
+   * Journal yang tertinggal dari sync() yang tidak selesai dipakai untuk
+   * mengembalikan file ke commit terakhir.
+   *
+   * @param filename Nama file
+   * @return false jika file tidak dapat dibuka atau bukan file halaman
+   */
+  bool open(const std::string& filename) {
+    close();
+    filename_ = filename;
+    file_ = fopen(filename.c_str(), "r+b");
+    if (!file_) return reset();
+
+    char page[kPageSize];
+    if (!rollback() || !read(0, page)) {
+      close();
+      return false;
+    }
+
+    std::memcpy(&header_, page, sizeof(Header));
+    if (std::memcmp(header_.magic, kMagic, sizeof(kMagic)) != 0 ||
+        header_.page_size != kPageSize) {
+      close();
+      return false;
+    }
+
+    markCommitted();
+    created_ = false;
+    return true;
+  }
+
+  /**
+   * @brief Mengosongkan file (atau membuat file baru) dengan header kosong
+   *
+   * File mendapat salt baru, sehingga journal milik isi sebelumnya tidak
+   * akan pernah diterapkan ke file ini.
+   */
+  bool reset() {
+    close();
+    file_ = fopen(filename_.c_str(), "w+b");
+    if (!file_) return false;
+
+    header_ = Header{};
+    std::memcpy(header_.magic, kMagic, sizeof(kMagic));
+    header_.version = 1;
+    header_.page_size = kPageSize;
+    header_.page_count = 1;
+    header_.salt = std::random_device{}() | uint64_t{1} << 63;
+    created_ = true;
+    committed_pages_ = 0;
+    if (!writeHeader() || !syncToDisk(file_)) return false;
+
+    std::remove(journalName().c_str());
+    markCommitted();
+    return true;
+  }
+
+  bool isOpen() const { return file_ != nullptr; }
+
+  /**
+   * @return true jika file baru dibuat (atau dikosongkan) saat dibuka
+   */
+  bool created() const { return created_; }
+
+  Header& header() { return header_; }
+
+  /**
+   * @brief Mengambil nomor halaman baru di akhir file
+   *
+   * Halaman baru ditulis oleh BufferPool sebelum pernah dibaca.
+   */
+  PageId allocate() { return header_.page_count++; }
+
+  bool read(PageId id, char* data) {
+    RAIVFY_COUNT(kBytesRead, kPageSize);
+    return file_ && seek(id) && fread(data, 1, kPageSize, file_) == kPageSize;
+  }
+
+  /**
+   * @brief Menulis halaman, menyalin isi lamanya ke journal terlebih dahulu
+   *
+   */
+  bool write(PageId id, const char* data) {
+    if (!journal(id) || !syncJournal()) return false;
+    modified_ = true;
+    return writePage(id, data);
+  }
+
+  /**
+   * @brief Menyalin isi halaman saat commit terakhir ke journal
+   *
+   * Setiap halaman cukup disalin sekali per commit, halaman yang dibuat
+   * setelah commit tidak perlu disalin. Journal belum di-fsync, sehingga
+   * beberapa halaman dapat disalin sekaligus sebelum write() pertama.
+   */
+  bool journal(PageId id) {
+    if (id >= committed_pages_ || journaled_.count(id)) return true;
+
+    if (!journal_) {
+      journal_ = fopen(journalName().c_str(), "wb");
+      if (!journal_ ||
+          fwrite(&committed_.salt, sizeof(uint64_t), 1, journal_) != 1) {
+        return false;
+      }
+    }
+
+    char page[kPageSize];
+    if (!read(id, page)) return false;
+    uint64_t sum = checksum(id, page);
+    if (fwrite(&id, sizeof(id), 1, journal_) != 1 ||
+        fwrite(&sum, sizeof(sum), 1, journal_) != 1 ||
+        fwrite(page, 1, kPageSize, journal_) != kPageSize) {
+      return false;
+    }
+
+    journaled_.insert(id);
+    journal_synced_ = false;
+    return true;
+  }
+
+  /**
+   * @brief Commit: halaman data, lalu header, lalu journal dihapus
+   *
+   */
+  bool sync() {
+    if (!modified_ && !journal_ &&
+        std::memcmp(&header_, &committed_, sizeof(Header)) == 0) {
+      return true;
+    }
+
+    // Header baru tidak boleh sampai di disk sebelum halaman yang dirujuknya
+    if (!syncToDisk(file_) || !writeHeader() || !syncToDisk(file_)) {
+      return false;
+    }
+
+    if (journal_) fclose(journal_);
+    journal_ = nullptr;
+    std::remove(journalName().c_str());
+    markCommitted();
+    return true;
+  }
+
+  void close() {
+    if (file_) fclose(file_);
+    if (journal_) fclose(journal_);
+    file_ = journal_ = nullptr;
+    journaled_.clear();
+  }
+
+  /**
+   * @brief Menutup file tanpa commit lalu menghapus file beserta journal-nya
+   *
+   */
+  void remove() {
+    close();
+    std::remove(filename_.c_str());
+    std::remove(journalName().c_str());
+  }
+
+ private:
+  static constexpr char kMagic[8] = {'R', 'A', 'i', 'V', 'F', 'Y', 'B', 'T'};
+
+  FILE* file_{nullptr};     /**< File halaman */
+  FILE* journal_{nullptr};  /**< Journal commit yang sedang berjalan */
+  std::string filename_;    /**< Nama file, dipakai ulang oleh reset() */
+  Header header_{};         /**< Salinan header di memori */
+  Header committed_{};      /**< Header pada commit terakhir */
+  PageId committed_pages_{0};  /**< Jumlah halaman pada commit terakhir */
+  std::unordered_set<PageId> journaled_; /**< Halaman yang sudah disalin */
+  bool journal_synced_{true};  /**< Seluruh isi journal sudah di-fsync */
+  bool modified_{false};       /**< Ada halaman ditulis sejak commit */
+  bool created_{false};        /**< File baru dibuat saat dibuka */
+
+  std::string journalName() const { return filename_ + "-journal"; }
+
+  bool seek(PageId id) {
+#ifdef __WIN32__
+    return _fseeki64(file_, static_cast<long long>(id * kPageSize), SEEK_SET) ==
+           0;
+#else
+    return fseeko(file_, static_cast<off_t>(id * kPageSize), SEEK_SET) == 0;
+#endif
+  }
+
+  bool writePage(PageId id, const char* data) {
+    RAIVFY_COUNT(kBytesWritten, kPageSize);
+    return file_ && seek(id) &&
+           fwrite(data, 1, kPageSize, file_) == kPageSize;
+  }
+
+  bool writeHeader() {
+    char page[kPageSize]{};
+    std::memcpy(page, &header_, sizeof(Header));
+    return write(0, page);
+  }
+
+  bool syncJournal() {
+    if (journal_synced_) return true;
+    journal_synced_ = syncToDisk(journal_);
+    return journal_synced_;
+  }
+
+  void markCommitted() {
+    committed_ = header_;
+    committed_pages_ = header_.page_count;
+    journaled_.clear();
+    journal_synced_ = true;
+    modified_ = false;
+  }
+
+  /**
+   * @brief Mengembalikan halaman dari journal milik file ini (jika ada)
+   *
+   * Record yang terpotong atau checksum-nya salah belum pernah di-fsync,
+   * artinya halaman aslinya juga belum ditimpa, sehingga dilewati.
+   */
+  bool rollback() {
+    FILE* journal = fopen(journalName().c_str(), "rb");
+    if (!journal) return true;
+
+    char page[kPageSize];
+    uint64_t salt = 0;
+    bool owned = read(0, page) &&
+                 fread(&salt, sizeof(salt), 1, journal) == 1 &&
+                 std::memcmp(&salt, page + offsetof(Header, salt),
+                             sizeof(salt)) == 0;
+
+    PageId id;
+    uint64_t sum;
+    bool ok = true;
+    while (owned && fread(&id, sizeof(id), 1, journal) == 1 &&
+           fread(&sum, sizeof(sum), 1, journal) == 1 &&
+           fread(page, 1, kPageSize, journal) == kPageSize) {
+      if (sum == checksum(id, page)) ok = writePage(id, page) && ok;
+    }
+    fclose(journal);
+
+    if (!ok || !syncToDisk(file_)) return false;
+    std::remove(journalName().c_str());
+    return true;
+  }
+
+  /**
+   * @brief Checksum FNV-1a untuk satu record journal
+   *
+   */
+  static uint64_t checksum(PageId id, const char* page) {
+    uint64_t hash = 14695981039346656037ull ^ id;
+    for (size_t i = 0; i < kPageSize; i++) {
+      hash = (hash ^ static_cast<unsigned char>(page[i])) * 1099511628211ull;
+    }
+    return hash;
+  }
+
+  /**
+   * @brief Mengosongkan buffer stdio dan memastikan isinya sampai di disk
+   *
+   */
+  static bool syncToDisk(FILE* file) {
+    if (fflush(file) != 0) return false;
+#ifdef __WIN32__
+    return true;
+#else
+    return fsync(fileno(file)) == 0;
+#endif
+  }
+};
+
+/**
+ * @class BufferPool
+ * @brief Cache halaman berukuran tetap di atas PageFile
+ *
+ * Memori yang dipakai tidak pernah melebihi capacity halaman. Halaman yang
+ * sedang dipakai di-pin melalui PageRef, halaman lain dapat dikeluarkan
+ * dengan algoritma clock (second chance). Halaman yang berubah ditulis ke
+ * file saat dikeluarkan atau saat flush(). Tidak thread-safe, dipakai oleh
+ * satu thread pada satu waktu.
+ */
+class BufferPool {
+ public:
+  using PageId = PageFile::PageId;
+
+  /**
+   * @class PageRef
+   * @brief Pin halaman di buffer pool selama objek ini hidup
+   *
+   */
+  class PageRef {
+   public:
+    PageRef() = default;
+    PageRef(BufferPool* pool, size_t frame) : pool_(pool), frame_(frame) {}
+    PageRef(const PageRef&) = delete;
+    PageRef& operator=(const PageRef&) = delete;
+    PageRef(PageRef&& other) noexcept { *this = std::move(other); }
+
+    PageRef& operator=(PageRef&& other) noexcept {
+      if (this != &other) {
+        release();
+        pool_ = other.pool_;
+        frame_ = other.frame_;
+        other.pool_ = nullptr;
+      }
+      return *this;
+    }
+
+    ~PageRef() { release(); }
+
+    explicit operator bool() const { return pool_ != nullptr; }
+    char* data() { return pool_->frameData(frame_); }
+    PageId id() const { return pool_->frames_[frame_].id; }
+    void markDirty() { pool_->frames_[frame_].dirty = true; }
+
+    void release() {
+      if (pool_) pool_->frames_[frame_].pins--;
+      pool_ = nullptr;
+    }
+
+   private:
+    BufferPool* pool_{nullptr}; /**< Pool pemilik halaman */
+    size_t frame_{0};           /**< Indeks frame halaman */
+  };
+
+  /**
+   * @param file File halaman sumber
+   * @param capacity Jumlah halaman maksimal di memori (minimal 16)
+   */
+  BufferPool(PageFile& file, size_t capacity)
+      : file_(file),
+        frames_(std::max<size_t>(capacity, kMinFrames)),
+        memory_(frames_.size() * PageFile::kPageSize) {}
+
+  /**
+   * @brief Mengambil halaman, membacanya dari file jika belum ada di memori
+   *
+   * @return PageRef kosong jika pembacaan gagal atau seluruh frame di-pin
+   */
+  PageRef fetch(PageId id) {
+    auto cached = table_.find(id);
+    if (cached != table_.end()) {
+      hits_++;
+      return pin(cached->second);
+    }
+
+    misses_++;
+    size_t frame;
+    if (!acquireFrame(frame)) return PageRef();
+    if (!file_.read(id, frameData(frame))) return PageRef();
+
+    frames_[frame].id = id;
+    table_.emplace(id, frame);
+    return pin(frame);
+  }
+
+  /**
+   * @brief Membuat halaman baru berisi nol di akhir file
+   *
+   */
+  PageRef create() {
+    size_t frame;
+    if (!acquireFrame(frame)) return PageRef();
+
+    PageId id = file_.allocate();
+    std::memset(frameData(frame), 0, PageFile::kPageSize);
+    frames_[frame].id = id;
+    frames_[frame].dirty = true;
+    table_.emplace(id, frame);
+    return pin(frame);
+  }
+
+  /**
+   * @brief Menulis seluruh halaman yang berubah ke file
+   *
+   * Isi lama seluruh halaman disalin ke journal lebih dulu, sehingga journal
+   * cukup di-fsync sekali sebelum halaman pertama ditimpa.
+   */
+  bool flush() {
+    for (size_t i = 0; i < frames_.size(); i++) {
+      if (frames_[i].id != PageFile::kNoPage && frames_[i].dirty &&
+          !file_.journal(frames_[i].id)) {
+        return false;
+      }
+    }
+
+    bool ok = true;
+    for (size_t i = 0; i < frames_.size(); i++) {
+      if (frames_[i].id != PageFile::kNoPage && frames_[i].dirty) {
+        ok = file_.write(frames_[i].id, frameData(i)) && ok;
+        frames_[i].dirty = false;
+      }
+    }
+    return ok;
+  }
+
+  /**
+   * @brief Membuang seluruh halaman tanpa menulisnya (file dikosongkan)
+   *
+   */
+  void discard() {
+    for (Frame& frame : frames_) frame = Frame();
+    table_.clear();
+  }
+
+  size_t capacity() const { return frames_.size(); }
+  size_t hits() const { return hits_; }
+  size_t misses() const { return misses_; }
+
+ private:
+  static constexpr size_t kMinFrames = 16; /**< Cukup untuk jalur root-leaf */
+
+  /**
+   * @brief Status satu frame
+   *
+   */
+  struct Frame {
+    PageId id{PageFile::kNoPage}; /**< Halaman di frame ini */
+    unsigned pins{0};             /**< Jumlah PageRef aktif */
+    bool dirty{false};            /**< Berubah sejak dibaca / ditulis */
+    bool referenced{false};       /**< Bit second chance untuk clock */
+  };
+
+  PageFile& file_;                            /**< File halaman */
+  std::vector<Frame> frames_;                 /**< Status setiap frame */
+  std::vector<char> memory_;                  /**< Isi seluruh frame */
+  std::unordered_map<PageId, size_t> table_;  /**< Halaman ke frame */
+  size_t hand_{0};                            /**< Posisi jarum clock */
+  size_t hits_{0}, misses_{0};                /**< Statistik fetch() */
+
+  char* frameData(size_t frame) {
+    return memory_.data() + frame * PageFile::kPageSize;
+  }
+
+  PageRef pin(size_t frame) {
+    frames_[frame].pins++;
+    frames_[frame].referenced = true;
+    return PageRef(this, frame);
+  }
+
+  /**
+   * @brief Mencari frame kosong atau mengeluarkan halaman dengan clock
+   *
+   */
+  bool acquireFrame(size_t& result) {
+    for (size_t step = 0; step < 2 * frames_.size(); step++) {
+      size_t frame = hand_;
+      hand_ = (hand_ + 1) % frames_.size();
+
+      Frame& candidate = frames_[frame];
+      if (candidate.pins > 0) continue;
+      if (candidate.referenced) {
+        candidate.referenced = false;
+        continue;
+      }
+
+      if (candidate.id != PageFile::kNoPage) {
+        if (candidate.dirty && !file_.write(candidate.id, frameData(frame))) {
+          return false;
+        }
+        table_.erase(candidate.id);
+      }
+
+      candidate = Frame();
+      result = frame;
+      return true;
+    }
+    return false;
+  }
+};
+
+/**
+ * @class BPlusTree
+ * @brief B+-tree dengan key 128-bit dan value berukuran tetap di atas
+ * BufferPool
+ *
+ * Seluruh value berada di leaf, leaf saling terhubung dua arah sehingga range
+ * scan dapat berjalan maju maupun mundur. Penghapusan bersifat lazy: key
+ * dihapus dari leaf tanpa penggabungan node, ruang kosong dipakai lagi oleh
+ * penambahan berikutnya. Saat leaf paling kanan penuh karena penambahan
+ * berurutan, leaf baru hanya berisi key baru sehingga leaf lama tetap penuh.
+ */
+class BPlusTree {
+ public:
+  using PageId = PageFile::PageId;
+
+  /**
+   * @brief Key komposit, dibandingkan berdasarkan major lalu minor
+   *
+   */
+  struct Key {
+    uint64_t major; /**< Kolom utama */
+    uint64_t minor; /**< Pemecah seri (misalnya ID lagu) */
+
+    bool operator<(const Key& other) const {
+      return major != other.major ? major < other.major : minor < other.minor;
+    }
+    bool operator==(const Key& other) const {
+      return major == other.major && minor == other.minor;
+    }
+  };
+
+  static constexpr Key kMinKey{0, 0}; /**< Key terkecil */
+  static constexpr Key kMaxKey{UINT64_MAX, UINT64_MAX}; /**< Key terbesar */
+
+  /**
+   * @param pool Buffer pool tempat node dibaca
+   * @param root Slot root tree di header PageFile
+   * @param value_size Ukuran value setiap key (boleh 0)
+   */
+  BPlusTree(BufferPool& pool, PageId& root, size_t value_size)
+      : pool_(pool),
+        root_(root),
+        value_size_(value_size),
+        leaf_capacity_((PageFile::kPageSize - sizeof(NodeHeader)) /
+                       (sizeof(Key) + value_size)),
+        internal_capacity_(
+            (PageFile::kPageSize - sizeof(NodeHeader) - sizeof(PageId)) /
+            (sizeof(Key) + sizeof(PageId))) {}
+
+  /**
+   * @brief Mencari value dari key
+   *
+   * @param value Buffer tujuan (value_size byte), boleh nullptr
+   * @return true jika key ditemukan
+   */
+  bool find(const Key& key, char* value) {
+    BufferPool::PageRef page = findLeaf(key);
+    if (!page) return false;
+
+    char* data = page.data();
+    size_t count = header(data).count;
+    size_t position = lowerBound(data, count, key);
+    if (position == count || !(keys(data)[position] == key)) return false;
+
+    if (value) std::memcpy(value, leafValue(data, position), value_size_);
+    return true;
+  }
+
+  /**
+   * @brief Menambahkan key atau mengganti value jika key sudah ada
+   *
+   * @param added Diisi true jika key belum ada sebelumnya
+   * @return false jika terjadi kegagalan I/O
+   */
+  bool insert(const Key& key, const char* value, bool& added) {
+    added = false;
+    if (root_ == PageFile::kNoPage) {
+      BufferPool::PageRef root = pool_.create();
+      if (!root) return false;
+      header(root.data()).leaf = 1;
+      root_ = root.id();
+    }
+
+    Split split;
+    if (!insertInto(root_, key, value, split, added)) return false;
+    if (!split.happened) return true;
+
+    BufferPool::PageRef root = pool_.create();
+    if (!root) return false;
+    char* data = root.data();
+    header(data).count = 1;
+    keys(data)[0] = split.key;
+    children(data)[0] = root_;
+    children(data)[1] = split.page;
+    root_ = root.id();
+    return true;
+  }
+
+  /**
+   * @brief Menghapus key
+   *
+   * @return true jika key ditemukan dan dihapus
+   */
+  bool erase(const Key& key) {
+    BufferPool::PageRef page = findLeaf(key);
+    if (!page) return false;
+
+    char* data = page.data();
+    NodeHeader& node = header(data);
+    size_t position = lowerBound(data, node.count, key);
+    if (position == node.count || !(keys(data)[position] == key)) {
+      return false;
+    }
+
+    size_t tail = node.count - position - 1;
+    std::memmove(&keys(data)[position], &keys(data)[position + 1],
+                 tail * sizeof(Key));
+    std::memmove(leafValue(data, position), leafValue(data, position + 1),
+                 tail * value_size_);
+    node.count--;
+    page.markDirty();
+    return true;
+  }
+
+  /**
+   * @brief Menelusuri key dalam rentang [first, last] secara berurutan
+   *
+   * @param visit Dipanggil dengan (const Key&, const char* value), berhenti
+   * jika mengembalikan false
+   * @param descending Telusuri dari key terbesar
+   */
+  template <typename Visitor>
+  void scan(const Key& first, const Key& last, Visitor visit,
+            bool descending = false) {
+    if (last < first) return;
+
+    BufferPool::PageRef page = findLeaf(descending ? last : first);
+    if (!page) return;
+
+    char* data = page.data();
+    size_t count = header(data).count;
+    if (!descending) {
+      for (size_t i = lowerBound(data, count, first);;) {
+        for (; i < count; i++) {
+          const Key& key = keys(data)[i];
+          if (last < key) return;
+          if (!visit(key, leafValue(data, i))) return;
+        }
+
+        PageId next = header(data).next;
+        if (next == PageFile::kNoPage || !(page = pool_.fetch(next))) return;
+        data = page.data();
+        count = header(data).count;
+        i = 0;
+      }
+    }
+
+    for (size_t i = upperBound(data, count, last);;) {
+      for (; i > 0; i--) {
+        const Key& key = keys(data)[i - 1];
+        if (key < first) return;
+        if (!visit(key, leafValue(data, i - 1))) return;
+      }
+
+      PageId previous = header(data).previous;
+      if (previous == PageFile::kNoPage || !(page = pool_.fetch(previous))) {
+        return;
+      }
+      data = page.data();
+      i = header(data).count;
+    }
+  }
+
+ private:
+  /**
+   * @brief Awal setiap halaman node
+   *
+   */
+  struct NodeHeader {
+    uint16_t leaf;     /**< 1 untuk leaf, 0 untuk node internal */
+    uint16_t count;    /**< Jumlah key */
+    uint32_t reserved; /**< Padding */
+    PageId next;       /**< Leaf berikutnya */
+    PageId previous;   /**< Leaf sebelumnya */
+  };
+
+  /**
+   * @brief Hasil split node untuk diteruskan ke parent
+   *
+   */
+  struct Split {
+    bool happened{false}; /**< Node terbelah */
+    Key key{};            /**< Key pemisah untuk parent */
+    PageId page{PageFile::kNoPage}; /**< Node baru di sebelah kanan */
+  };
+
+  BufferPool& pool_;              /**< Sumber halaman */
+  PageId& root_;                  /**< Slot root di header file */
+  const size_t value_size_;       /**< Ukuran value */
+  const size_t leaf_capacity_;    /**< Key maksimal per leaf */
+  const size_t internal_capacity_; /**< Key maksimal per node internal */
+
+  static NodeHeader& header(char* data) {
+    return *reinterpret_cast<NodeHeader*>(data);
+  }
+  static Key* keys(char* data) {
+    return reinterpret_cast<Key*>(data + sizeof(NodeHeader));
+  }
+  PageId* children(char* data) const {
+    return reinterpret_cast<PageId*>(data + sizeof(NodeHeader) +
+                                     internal_capacity_ * sizeof(Key));
+  }
+  char* leafValue(char* data, size_t index) const {
+    return data + sizeof(NodeHeader) + leaf_capacity_ * sizeof(Key) +
+           index * value_size_;
+  }
+
+  static size_t lowerBound(char* data, size_t count, const Key& key) {
+    return static_cast<size_t>(std::lower_bound(keys(data), keys(data) + count,
+                                                key) -
+                               keys(data));
+  }
+  static size_t upperBound(char* data, size_t count, const Key& key) {
+    return static_cast<size_t>(std::upper_bound(keys(data), keys(data) + count,
+                                                key) -
+                               keys(data));
+  }
+
+  /**
+   * @brief Turun dari root ke leaf yang seharusnya berisi key
+   *
+   */
+  BufferPool::PageRef findLeaf(const Key& key) {
+    if (root_ == PageFile::kNoPage) return BufferPool::PageRef();
+
+    BufferPool::PageRef page = pool_.fetch(root_);
+    while (page && !header(page.data()).leaf) {
+      char* data = page.data();
+      PageId child = children(data)[upperBound(data, header(data).count, key)];
+      page = pool_.fetch(child);
+    }
+    return page;
+  }
+
+  bool insertInto(PageId id, const Key& key, const char* value, Split& split,
+                  bool& added) {
+    BufferPool::PageRef page = pool_.fetch(id);
+    if (!page) return false;
+
+    char* data = page.data();
+    if (header(data).leaf) {
+      return insertIntoLeaf(page, key, value, split, added);
+    }
+
+    size_t index = upperBound(data, header(data).count, key);
+    Split child_split;
+    if (!insertInto(children(data)[index], key, value, child_split, added)) {
+      return false;
+    }
+    if (!child_split.happened) return true;
+
+    return insertIntoInternal(page, index, child_split, split);
+  }
+
+  bool insertIntoLeaf(BufferPool::PageRef& page, const Key& key,
+                      const char* value, Split& split, bool& added) {
+    char* data = page.data();
+    NodeHeader& node = header(data);
+    size_t position = lowerBound(data, node.count, key);
+
+    if (position < node.count && keys(data)[position] == key) {
+      if (value_size_) {
+        std::memcpy(leafValue(data, position), value, value_size_);
+      }
+      page.markDirty();
+      return true;
+    }
+
+    added = true;
+    page.markDirty();
+    if (node.count < leaf_capacity_) {
+      placeInLeaf(data, position, key, value);
+      return true;
+    }
+
+    BufferPool::PageRef sibling = pool_.create();
+    if (!sibling) return false;
+    char* right = sibling.data();
+    NodeHeader& right_node = header(right);
+    right_node.leaf = 1;
+
+    // Penambahan di ujung kanan tree: leaf lama dibiarkan penuh
+    bool append = position == node.count && node.next == PageFile::kNoPage;
+    size_t middle = append ? node.count : node.count / 2;
+    size_t moved = node.count - middle;
+
+    std::memcpy(keys(right), &keys(data)[middle], moved * sizeof(Key));
+    std::memcpy(leafValue(right, 0), leafValue(data, middle),
+                moved * value_size_);
+    right_node.count = static_cast<uint16_t>(moved);
+    node.count = static_cast<uint16_t>(middle);
+
+    right_node.next = node.next;
+    right_node.previous = page.id();
+    if (node.next != PageFile::kNoPage) {
+      BufferPool::PageRef next = pool_.fetch(node.next);
+      if (!next) return false;
+      header(next.data()).previous = sibling.id();
+      next.markDirty();
+    }
+    node.next = sibling.id();
+
+    if (position <= middle && !append) {
+      placeInLeaf(data, position, key, value);
+    } else {
+      placeInLeaf(right, position - middle, key, value);
+    }
+
+    split.happened = true;
+    split.key = keys(right)[0];
+    split.page = sibling.id();
+    return true;
+  }
+
+  void placeInLeaf(char* data, size_t position, const Key& key,
+                   const char* value) {
+    NodeHeader& node = header(data);
+    size_t tail = node.count - position;
+    std::memmove(&keys(data)[position + 1], &keys(data)[position],
+                 tail * sizeof(Key));
+    std::memmove(leafValue(data, position + 1), leafValue(data, position),
+                 tail * value_size_);
+    keys(data)[position] = key;
+    if (value_size_) std::memcpy(leafValue(data, position), value, value_size_);
+    node.count++;
+  }
+
+  bool insertIntoInternal(BufferPool::PageRef& page, size_t index,
+                          const Split& child_split, Split& split) {
+    char* data = page.data();
+    NodeHeader& node = header(data);
+    page.markDirty();
+
+    if (node.count < internal_capacity_) {
+      size_t tail = node.count - index;
+      std::memmove(&keys(data)[index + 1], &keys(data)[index],
+                   tail * sizeof(Key));
+      std::memmove(&children(data)[index + 2], &children(data)[index + 1],
+                   tail * sizeof(PageId));
+      keys(data)[index] = child_split.key;
+      children(data)[index + 1] = child_split.page;
+      node.count++;
+      return true;
+    }
+
+    // Node penuh: gabungkan di buffer sementara lalu bagi dua
+    std::vector<Key> all_keys(keys(data), keys(data) + node.count);
+    std::vector<PageId> all_children(children(data),
+                                     children(data) + node.count + 1);
+    all_keys.insert(all_keys.begin() + index, child_split.key);
+    all_children.insert(all_children.begin() + index + 1, child_split.page);
+
+    BufferPool::PageRef sibling = pool_.create();
+    if (!sibling) return false;
+    char* right = sibling.data();
+
+    size_t middle = all_keys.size() / 2;
+    size_t right_count = all_keys.size() - middle - 1;
+
+    node.count = static_cast<uint16_t>(middle);
+    std::copy(all_keys.begin(), all_keys.begin() + middle, keys(data));
+    std::copy(all_children.begin(), all_children.begin() + middle + 1,
+              children(data));
+
+    header(right).count = static_cast<uint16_t>(right_count);
+    std::copy(all_keys.begin() + middle + 1, all_keys.end(), keys(right));
+    std::copy(all_children.begin() + middle + 1, all_children.end(),
+              children(right));
+
+    split.happened = true;
+    split.key = all_keys[middle];
+    split.page = sibling.id();
+    return true;
+  }
+};
+#pragma endregion
+
+#pragma region Song-Specified
+#pragma region Song Data Structure
+/**
+ * @class Song
+ * @brief Struct Song merepresentasikan satu entitas lagu dalam sistem.
+ *
+ * Struct ini menyimpan informasi seperti judul lagu, artis, genre, durasi,
+ * tahun rilis, dan jumlah pemutaran. Struct ini juga menyediakan fungsi
+ * untuk serialisasi dan deserialisasi sehingga dapat disimpan atau dibaca dari
+ * file biner.
+ */
+struct Song {
+  static std::atomic<size_t>
+      id_counter; /**< variabel static untuk auto-increment ID */
+  size_t id;                /**< ID yang nilainya berdasarkan id_counter */
+  char title[255];          /**< Judul Lagu */
+  char artist[255];         /**< Nama penyanyi / pencipta lagu */
+  char genre[255];          /**< Genre lagu */
+  int release_year;         /**< Tahun rilis lagu */
+  size_t duration;          /**< Durasi lagu dalam detik */
+  size_t play_count;        /**< Jumlah pemutaran lagu */
+
+  static constexpr size_t kRecordSize =
+      sizeof(size_t) + 3 * 255 + sizeof(int) +
+      2 * sizeof(size_t); /**< Ukuran satu record lagu di file biner */
+
+  /**
+   * @brief Constructor default, mengatur id berdasarkan id_counter
+   *
+   */
+  Song() : id(id_counter) {
+    std::strcpy(title, "");
+    std::strcpy(artist, "");
+    std::strcpy(genre, "");
+  }
+
+  /**
+   * @brief Constructor berparameter untuk membuat Song berdasarkan nilai
+   * spesifik
+   *
+   * @param title Judul lagu
+   * @param artist Nama penyanyi / pencipta
+   * @param genre Genre lagu
+   * @param release_year Tahun rilis lagu
+   * @param duration Durasi waktu dalam detik
+   * @param play_count jumlah pemutaran awal (opsional, default = 0)
+   */
+  Song(const char* _title, const char* _artist, const char* _genre,
+       int release_year, size_t duration, size_t play_count = 0)
+      : id(id_counter++),
+        release_year(release_year),
+        duration(duration),
+        play_count(play_count) {
+    std::strncpy(title, _title, 254);
+    std::strncpy(artist, _artist, 254);
+    std::strncpy(genre, _genre, 254);
+  }
+
+  /**
+   * @brief Operator pembanding untuk mengetahui apakah dua lagu sama.
+   *
+   * Dua lagu dianggap sama jika `title` dan `artist` nya sama.
+   *
+   * @param rhs Lagu lain yang ingin dibandingkan.
+   * @return true jika kedua lagu memiliki judul dan artis yang sama.
+   */
+  bool operator==(const Song& rhs) const {
+    // return std::memcmp(title, rhs.title, sizeof(title) == 0) &&
+    //        memcmp(artist, rhs.artist, sizeof(title) == 0);
+
+    return id == rhs.id;
+  }
+
+  /**
+   * @brief Operator pembanding tidak sama.
+   *
+   * @param rhs Lagu lain yang ingin dibandingkan.
+   * @return true jika lagu berbeda (berdasarkan title dan artist).
+   */
+  bool operator!=(const Song& rhs) const { return !(*this == rhs); }
+
+  /**
+   * @brief Operasi penyimpanan seluruh atribut lagu ke dalam file biner.
+   *
+   * Fungsi ini digunakan oleh FileManager untuk menyimpan data `Song`
+   * menggunakan fungsi `write()` yang sesuai tipe datanya.
+   *
+   * @return true jika seluruh proses penulisan berhasil.
+   */
+  bool serialize(Writer& out) const {
+    return out.write<size_t>(id) && out.write(title, 255) &&
+           out.write(genre, 255) && out.write(artist, 255) &&
+           out.write<int>(release_year) && out.write<size_t>(duration) &&
+           out.write<size_t>(play_count);
+  }
+
+  /**
+   * @brief Operasi pembacaan atribut lagu dari file biner.
+   *
+   * Fungsi ini digunakan oleh FileManager untuk memuat data `Song`
+   * menggunakan fungsi `read()` yang sesuai tipe datanya.
+   * Panjang string dibaca terlebih dahulu, lalu isinya.
+   *
+   * @return true jika seluruh proses pembacaan berhasil.
+   */
+  bool deserialize(Reader& in) {
+    if (!in.read<size_t>(id)) return false;
+
+    if (!in.read(&title[0], 255)) return false;
+    if (!in.read(&genre[0], 255)) return false;
+    if (!in.read(&artist[0], 255)) return false;
+
+    title[254] = genre[254] = artist[254] = '\0';
+
+    if (!in.read<int>(release_year)) return false;
+    if (!in.read<size_t>(duration)) return false;
+    if (!in.read<size_t>(play_count)) return false;
+
+    return true;
+  }
+};
+#pragma endregion
+
+#pragma region Sorting Algorithm Implementation
+/**
+ * @class SongSorter
+ * @brief Implementasi algoritma sorting (pengurutan) untuk objek Song.
+ *
+ * Kelas ini menyediakan metode Bubble Sort dan Quick Sort yang dapat digunakan
+ * secara fleksibel dengan comparator untuk berbagai field (judul, id, dll).
+ */
+
+class SongSorter {
+ public:
+  /**
+   * @brief Comparator untuk mengurutkan berdasarkan judul lagu (ascending).
+   *
+   * Comparator digunakan untuk membuat algoritma pengurutan dapat digunakan
+   * secara fleksibel untuk mengurutkan data berdasrkan field tertentu
+   */
+  static inline auto by_title = [](const Song& a, const Song& b) {
+    return std::strcmp(a.title, b.title) < 0;
+  };
+
+  /**
+   * @brief Comparator untuk mengurutkan berdasarkan ID lagu (ascending).
+   */
+  static inline auto by_id = [](const Song& a, const Song& b) {
+    return a.id < b.id;
+  };
+
+  /**
+   * @brief Comparator untuk mengurutkan berdasarkan jumlah pemutaran lagu
+   * (ascending).
+   */
+  static inline auto by_play_count = [](const Song& a, const Song& b) {
+    return a.play_count < b.play_count;
+  };
+
+  /**
+   * @brief Comparator untuk mengurutkan berdasarkan tahun rilis lagu
+   * (ascending).
+   */
+  static inline auto by_release_year = [](const Song& a, const Song& b) {
+    return a.release_year < b.release_year;
+  };
+
+  /**
+   * @brief Memastikan ArrayList Song telah terurut berdasarkan ID.
+   *
+   * Data yang sudah terurut hanya diperiksa (O(n)). Jika belum, memilih
+   * algoritma quickSort untuk data > 30 elemen, bubbleSort jika ≤ 30.
+   * @param data ArrayList lagu yang akan diurutkan.
+   */
+  static void ensureSortedByID(ArrayList<Song>& data) {
+    RAIVFY_TIMED(kSort);
+    bool sorted = true;
+    for (size_t i = 1; i < data.size() && sorted; i++) {
+      sorted = !by_id(data.arr[i], data.arr[i - 1]);
+    }
+    if (sorted) return;
+
+    if (data.size() > kQuickSortThreshold) {
+      quickSort(data, 0, data.size() - 1, by_id);
+    } else {
+      bubbleSort(data, by_id);
+    }
+  }
+
+  /**
+   * @brief Mengurutkan data menggunakan Bubble Sort.
+   *
+   * @param data ArrayList data lagu.
+   * @param comparator Fungsi pembanding untuk menentukan urutan.
+   */
+  static void bubbleSort(
+      ArrayList<Song>& data,
+      std::function<bool(const Song&, const Song&)> comparator) {
+    RAIVFY_TIMED(kSort);
+    if (data.empty()) return;
+
+    for (size_t i = 0; i < data.size(); ++i) {
+      for (size_t j = 0; j < data.size() - i - 1; ++j) {
+        if (comparator(data.arr[j + 1], data.arr[j])) {
+          swap(&data.arr[j], &data.arr[j + 1]);
+        }
+      }
+    }
+  }
+
+  /**
+   * @brief Mengurutkan data menggunakan Quick Sort.
+   *
+   * Pivot dipilih dengan median-of-three sehingga data yang sudah (hampir)
+   * terurut tidak jatuh ke kasus terburuk O(n^2). Rekursi hanya dilakukan
+   * pada bagian yang lebih kecil, kedalaman stack paling banyak O(log n).
+   *
+   * @param data ArrayList data lagu.
+   * @param awal Indeks awal.
+   * @param akhir Indeks akhir.
+   * @param comparator Fungsi pembanding untuk menentukan urutan.
+   */
+  static void quickSort(
+      ArrayList<Song>& data, size_t awal, size_t akhir,
+      std::function<bool(const Song&, const Song&)> comparator) {
+    RAIVFY_TIMED(kSort);
+    quickSortRange(data.arr, awal, akhir, comparator,
+                   [](const Song& song) -> const Song& { return song; });
+  }
+
+  /**
+   * @brief Mengurutkan indeks lagu menggunakan Quick Sort tanpa memindahkan
+   * data lagu.
+   *
+   * @param data ArrayList data lagu.
+   * @param order Indeks lagu yang akan diurutkan.
+   * @param awal Posisi awal pada order.
+   * @param akhir Posisi akhir pada order.
+   * @param comparator Fungsi pembanding untuk menentukan urutan.
+   */
+  static void quickSort(
+      const ArrayList<Song>& data, std::vector<size_t>& order, size_t awal,
+      size_t akhir, std::function<bool(const Song&, const Song&)> comparator) {
+    RAIVFY_TIMED(kSort);
+    quickSortRange(order.data(), awal, akhir, comparator,
+                   [&data](size_t index) -> const Song& {
+                     return data.arr[index];
+                   });
+  }
+
+  /**
+   * @brief Membalikkan urutan comparator menjadi descending.
+   *
+   * @tparam T Tipe data (misalnya: Song).
+   * @param comparator Fungsi pembanding ascending.
+   * @return Comparator yang hasilnya dibalik.
+   */
+  template <typename T>
+  static std::function<bool(const T&, const T&)> reverseOrder(
+      std::function<bool(const T&, const T&)> comparator) {
+    return [comparator](const T& a, const T& b) { return comparator(b, a); };
+  }
+
+ private:
+  static constexpr size_t kQuickSortThreshold = 30;
+  /**
+   * @brief Implementasi Quick Sort untuk array lagu maupun array indeks lagu
+   *
+   * @param items Elemen yang diurutkan (Song atau indeks lagu).
+   * @param key Proyeksi elemen ke lagu yang dibandingkan.
+   */
+  template <typename Element, typename Key>
+  static void quickSortRange(
+      Element* items, size_t awal, size_t akhir,
+      const std::function<bool(const Song&, const Song&)>& comparator,
+      Key key) {
+    while (awal < akhir) {
+      // [lebih_kecil, lebih_besar) berisi elemen yang sama dengan pivot
+      std::pair<size_t, size_t> sama =
+          partition(items, awal, akhir, comparator, key);
+      size_t lebih_kecil = sama.first, lebih_besar = sama.second;
+
+      if (lebih_kecil - awal < akhir + 1 - lebih_besar) {
+        if (lebih_kecil > awal) {
+          quickSortRange(items, awal, lebih_kecil - 1, comparator, key);
+        }
+        if (lebih_besar > akhir) break;
+        awal = lebih_besar;
+      } else {
+        if (lebih_besar < akhir) {
+          quickSortRange(items, lebih_besar, akhir, comparator, key);
+        }
+        if (lebih_kecil == awal) break;
+        akhir = lebih_kecil - 1;
+      }
+    }
+  }
+
+  /**
+   * @brief Fungsi partisi tiga arah (Dutch national flag) pada quickSort.
+   *
+   * Pivot adalah median dari elemen awal, tengah, dan akhir. Elemen yang
+   * sama dengan pivot dikumpulkan di tengah dan tidak ikut diurutkan lagi,
+   * sehingga data dengan banyak kunci sama (misalnya tahun rilis) tetap
+   * O(n log n).
+   *
+   * @param items Elemen yang dipartisi.
+   * @param index_awal Indeks awal.
+   * @param index_akhir Indeks akhir.
+   * @param comparator Comparator untuk sorting.
+   * @param key Proyeksi elemen ke lagu yang dibandingkan.
+   * @return Rentang [first, second) berisi elemen yang sama dengan pivot.
+   */
+  template <typename Element, typename Key>
+  static std::pair<size_t, size_t> partition(
+      Element* items, size_t index_awal, size_t index_akhir,
+      const std::function<bool(const Song&, const Song&)>& comparator,
+      Key key) {
+    size_t tengah = index_awal + (index_akhir - index_awal) / 2;
+    if (comparator(key(items[tengah]), key(items[index_awal]))) {
+      std::swap(items[tengah], items[index_awal]);
+    }
+    if (comparator(key(items[index_akhir]), key(items[index_awal]))) {
+      std::swap(items[index_akhir], items[index_awal]);
+    }
+    if (comparator(key(items[tengah]), key(items[index_akhir]))) {
+      std::swap(items[tengah], items[index_akhir]);
+    }
+
+    Element pivot = items[index_akhir];
+    size_t lebih_kecil = index_awal, i = index_awal;
+    size_t lebih_besar = index_akhir + 1;
+
+    while (i < lebih_besar) {
+      if (comparator(key(items[i]), key(pivot))) {
+        std::swap(items[i++], items[lebih_kecil++]);
+      } else if (comparator(key(pivot), key(items[i]))) {
+        std::swap(items[i], items[--lebih_besar]);
+      } else {
+        i++;
+      }
+    }
+
+    return {lebih_kecil, lebih_besar};
+  }
+
+  /**
+   * @brief Menukar posisi dua elemen dalam array lagu.
+   *
+   * @param data1 Pointer ke elemen pertama.
+   * @param data2 Pointer ke elemen kedua.
+   */
+  static void swap(Song* data1, Song* data2) {
+    Song temporary = *data1;
+    *data1 = *data2;
+    *data2 = temporary;
+  }
+};
+
+/**
+ * @class SongView
+ * @brief Urutan tampilan lagu berupa permutasi indeks
+ *
+ * Data lagu tidak dipindahkan, sehingga database tetap terurut berdasarkan
+ * ID untuk binary search. Lagu pada baris tertentu diambil saat dibutuhkan.
+ * Tampilan juga dapat dibuat dari daftar ID saja (misalnya untuk SongStore),
+ * lagu pada baris tersebut dibaca melalui fungsi lookup saat ditampilkan.
+ */
+class SongView {
+ public:
+  using Lookup = std::function<bool(size_t, Song&)>;
+
+  explicit SongView(const ArrayList<Song>& data) : data_(&data) {}
+
+  /**
+   * @param ids ID lagu sesuai urutan tampilan
+   * @param lookup Fungsi pengambil lagu berdasarkan ID
+   */
+  SongView(std::vector<size_t> ids, Lookup lookup)
+      : order_(std::move(ids)), lookup_(std::move(lookup)) {}
+
+  size_t size() const { return data_ ? data_->size() : order_.size(); }
+
+  /**
+   * @brief Mengambil lagu pada baris tertentu sesuai urutan tampilan
+   *
+   * Pada tampilan berbasis ID, referensi hanya berlaku hingga at()
+   * dipanggil lagi.
+   *
+   * @param row Nomor baris (mulai dari 0)
+   * @return const Song& Lagu pada baris tersebut
+   */
+  const Song& at(size_t row) const {
+    if (!data_) {
+      if (!lookup_(order_[row], row_)) row_ = Song();
+      return row_;
+    }
+
+    bool sorted = order_.size() == data_->size();
+    return data_->arr[sorted ? order_[row] : row];
+  }
+
+  /**
+   * @brief Mengurutkan tampilan berdasarkan comparator
+   *
+   * Hanya untuk tampilan yang dibuat dari ArrayList.
+   *
+   * @param comparator Fungsi pembanding untuk menentukan urutan
+   */
+  void sortBy(std::function<bool(const Song&, const Song&)> comparator) {
+    RAIVFY_TIMED(kSort);
+    order_.resize(data_->size());
+    for (size_t i = 0; i < order_.size(); i++) order_[i] = i;
+    if (order_.size() > 1) {
+      SongSorter::quickSort(*data_, order_, 0, order_.size() - 1,
+                            comparator);
+    }
+  }
+
+  /**
+   * @brief Mengembalikan tampilan ke urutan data asli
+   *
+   */
+  void reset() {
+    if (data_) order_.clear();
+  }
+
+ private:
+  const ArrayList<Song>* data_{nullptr}; /**< Data lagu sumber */
+  std::vector<size_t> order_; /**< Indeks lagu terurut (kosong = asli) atau
+                                 ID lagu pada tampilan berbasis ID */
+  Lookup lookup_;             /**< Pengambil lagu tampilan berbasis ID */
+  mutable Song row_;          /**< Lagu terakhir yang diambil lookup_ */
+};
+#pragma endregion
+
+#pragma region Search Algorithm Implementation
+/**
+ * @class SongSearcher
+ * @brief Implementasi algoritma searching (penarian) untuk objek Song.
+ *
+ * Kelas ini mendukung pencarian berdasarkan genre, artis, dan judul lagu
+ * menggunakan algoritma Binary Search atau Linear Search
+ */
+class SongSearcher {
+ public:
+  static int result_index; /**< Indeks hasil dari pencarian binarySearch */
+
+  /**
+   * @brief Mencari lagu berdasarkan ID menggunakan algoritma Binary Search.
+   *
+   * Akan mengurutkan data terlebih dahulu jika belum terurut (diperiksa O(n)
+   * setiap pemanggilan). Untuk data yang pasti terurut, gunakan
+   * binarySearchSorted().
+   *
+   * @param target_id ID lagu yang dicari.
+   * @param data ArrayList lagu.
+   * @return true jika ditemukan, false jika tidak.
+   */
+  static bool binarySearch(size_t target_id, ArrayList<Song>& data) {
+    SongSorter::ensureSortedByID(data);
+    return binarySearchSorted(target_id, data);
+  }
+
+  /**
+   * @brief Binary Search berdasarkan ID tanpa memeriksa urutan data.
+   *
+   * @param target_id ID lagu yang dicari.
+   * @param data ArrayList lagu yang sudah terurut berdasarkan ID.
+   * @return true jika ditemukan, false jika tidak.
+   */
+  static bool binarySearchSorted(size_t target_id,
+                                 const ArrayList<Song>& data) {
+    RAIVFY_TIMED(kSearch);
+    if (data.empty()) return false;
+
+    int start{0}, mid{0}, end{static_cast<int>(data.size()) - 1};
+    while (start <= end) {
+      mid = (start + end) / 2;
+
+      if (target_id == data.arr[mid].id) {
+        result_index = mid;
+        return true;
+      }
+
+      if (target_id > data.arr[mid].id) {
+        start = mid + 1;
+      } else if (target_id < data.arr[mid].id) {
+        end = mid - 1;
+      }
+    }
+    result_index = -1;
+    return false;
+  }
+
+  /**
+   * @brief Mencari lagu berdasarkan genre (case-insensitive & substring).
+   *
+   * @param genre Genre yang dicari.
+   * @param data ArrayList lagu.
+   * @return ArrayList lagu yang cocok.
+   */
+  static ArrayList<Song> searchByGenre(const std::string& genre,
+                                       ArrayList<Song>& data) {
+    char normalized_genre[255];
+    std::strncpy(normalized_genre, normalizeString(genre.c_str()).c_str(), 254);
+
+    return linearSearch(data, [normalized_genre](const Song& song) {
+      char song_genre[255];
+      std::strncpy(song_genre, normalizeString(song.genre).c_str(), 254);
+      return std::strcmp(song_genre, normalized_genre) != 0 ? false : true;
+    });
+  }
+
+  /**
+   * @brief Mencari lagu berdasarkan artis (case-insensitive & substring).
+   *
+   * @param artist Nama artis.
+   * @param data ArrayList lagu.
+   * @return ArrayList lagu yang cocok.
+   */
+  static ArrayList<Song> searchByArtist(const std::string& artist,
+                                        ArrayList<Song>& data) {
+    char normalized_artist[255];
+    std::strncpy(normalized_artist, normalizeString(artist.c_str()).c_str(), 254);
+
+    return linearSearch(data, [normalized_artist](const Song& song) {
+      char song_artist[255];
+      std::strncpy(song_artist, normalizeString(song.artist).c_str(), 254);
+      return std::strcmp(song_artist, normalized_artist) != 0 ? false : true;
+    });
+  }
+
+  /**
+   * @brief Mencari lagu berdasarkan judul (case-insensitive & substring).
+   *
+   * @param title Judul lagu.
+   * @param data ArrayList lagu.
+   * @return ArrayList lagu yang cocok.
+   */
+  static ArrayList<Song> searchByTitle(const std::string& title,
+                                       ArrayList<Song>& data) {
+    char normalized_title[255];
+    std::strncpy(normalized_title, normalizeString(title.c_str()).c_str(), 254);
+
+    return linearSearch(data, [normalized_title](const Song& song) {
+      char song_title[255];
+      std::strncpy(song_title, normalizeString(song.title).c_str(), 254);
+      return std::strcmp(song_title, normalized_title) != 0 ? false : true;
+    });
+  }
+
+  /**
+   * @brief Menormalisasi string menjadi huruf kecil semua.
+   *
+   * @param string String asli.
+   * @return String hasil normalisasi.
+   */
+  static std::string normalizeString(const char* string) {
+    std::string normalized;
+
+    for (int i = 0; string[i] != '\0'; ++i) {
+      normalized += (unsigned char)std::tolower(string[i]);
+    }
+
+    return normalized;
+  }
+
+ private:
+  /**
+   * @brief Implementasi pencarian linear (filter) berdasarkan comparator.
+   *
+   * @param data ArrayList lagu.
+   * @param comparator Fungsi yang menentukan apakah lagu cocok.
+   * @return ArrayList lagu yang memenuhi kondisi comparator.
+   */
+  static ArrayList<Song> linearSearch(
+      ArrayList<Song>& data, std::function<bool(const Song&)> comparator) {
+    RAIVFY_TIMED(kSearch);
+    size_t index{0};
+    ArrayList<Song> filtered_library;
+    while (index < data.size()) {
+      if (comparator(data.arr[index])) {
+        filtered_library.add(data.arr[index]);
+      }
+      index++;
+    }
+    return filtered_library;
+  }
+
+};
+#pragma endregion
+
+#pragma region Main App
+/**
+ * @struct PlayRank
+ * @brief Satu entri peringkat lagu berdasarkan jumlah pemutaran
+ *
+ */
+struct PlayRank {
+  size_t id;          /**< ID lagu */
+  size_t play_count;  /**< Jumlah pemutaran lagu */
+  std::string title;  /**< Judul lagu */
+};
+
+/**
+ * @struct TrackInfo
+ * @brief Metadata lagu yang dibutuhkan saat pemutaran
+ *
+ */
+struct TrackInfo {
+  size_t id;         /**< ID lagu */
+  std::string title; /**< Judul lagu */
+  size_t duration;   /**< Durasi lagu dalam detik */
+};
+
+/**
+ * @struct CatalogSnapshot
+ * @brief Salinan metadata lagu dari database yang aman dibaca dari thread lain
+ *
+ * Hanya berisi lagu yang mungkin diputar (isi playlist yang sedang diputar),
+ * bukan seluruh database.
+ */
+struct CatalogSnapshot {
+  std::vector<TrackInfo> tracks; /**< Metadata lagu, terurut berdasarkan ID */
+
+  /**
+   * @brief Mencari metadata lagu berdasarkan ID (binary search)
+   *
+   * @param id ID lagu
+   * @return const TrackInfo* Metadata lagu, nullptr jika tidak ditemukan
+   */
+  const TrackInfo* find(size_t id) const {
+    auto track = std::lower_bound(
+        tracks.begin(), tracks.end(), id,
+        [](const TrackInfo& info, size_t target) { return info.id < target; });
+    return track != tracks.end() && track->id == id ? &*track : nullptr;
+  }
+};
+
+/**
+ * @class SongStore
+ * @brief Penyimpanan lagu di disk berbasis B+-tree
+ *
+ * Record lagu disimpan di leaf tree utama (key: ID), dengan tree sekunder
+ * untuk tahun rilis dan jumlah pemutaran (key: nilai kolom + ID, tanpa
+ * value). Seluruh akses melalui buffer pool berukuran tetap, sehingga memori
+ * yang dipakai tidak bergantung pada jumlah lagu.
+ */
+class SongStore {
+ public:
+  static constexpr size_t kDefaultPoolPages =
+      256; /**< Ukuran buffer pool default (1 MiB) */
+
+  /**
+   * @param pool_pages Jumlah halaman buffer pool
+   */
+  explicit SongStore(size_t pool_pages = kDefaultPoolPages)
+      : pool_(file_, pool_pages),
+        by_id_(pool_, file_.header().roots[kIdTree], Song::kRecordSize),
+        by_year_(pool_, file_.header().roots[kYearTree], 0),
+        by_play_count_(pool_, file_.header().roots[kPlayCountTree], 0) {}
+
+  SongStore(const SongStore&) = delete;
+  SongStore& operator=(const SongStore&) = delete;
+  ~SongStore() { flush(); }
+
+  /**
+   * @brief Membuka file store, membuat file kosong jika belum ada
+   *
+   * Perubahan pada file yang sedang terbuka di-commit terlebih dahulu.
+   *
+   * @return false jika file tidak dapat dibuka atau formatnya tidak dikenal
+   */
+  bool open(const std::string& filename) {
+    if (!flush()) return false;
+    pool_.discard();
+    return file_.open(filename);
+  }
+
+  bool isOpen() const { return file_.isOpen(); }
+
+  /**
+   * @brief Menutup store tanpa commit dan menghapus filenya
+   *
+   * Dipakai jika isi store tidak dapat dipercaya, misalnya migrasi gagal.
+   */
+  void remove() {
+    pool_.discard();
+    file_.remove();
+  }
+
+  /**
+   * @return true jika file store baru saja dibuat
+   */
+  bool created() const { return file_.created(); }
+
+  /**
+   * @return size_t Jumlah lagu dalam store
+   */
+  size_t size() { return file_.header().records; }
+
+  /**
+   * @brief Mengambil lagu berdasarkan ID
+   *
+   * @return true jika lagu ditemukan
+   */
+  bool get(size_t id, Song& song) {
+    char record[Song::kRecordSize];
+    if (!by_id_.find(idKey(id), record)) return false;
+    return decode(record, song);
+  }
+
+  /**
+   * @brief Menambahkan lagu atau mengganti lagu dengan ID yang sama
+   *
+   * @return false jika terjadi kegagalan I/O
+   */
+  bool put(const Song& song) {
+    Song previous;
+    if (get(song.id, previous)) {
+      by_year_.erase(yearKey(previous));
+      by_play_count_.erase(playCountKey(previous));
+    }
+
+    char record[Song::kRecordSize];
+    encode(song, record);
+
+    bool added, unused;
+    if (!by_id_.insert(idKey(song.id), record, added) ||
+        !by_year_.insert(yearKey(song), nullptr, unused) ||
+        !by_play_count_.insert(playCountKey(song), nullptr, unused)) {
+      return false;
+    }
+
+    if (added) file_.header().records++;
+    return true;
+  }
+
+  /**
+   * @brief Menghapus lagu berdasarkan ID
+   *
+   * @return true jika lagu ditemukan dan dihapus
+   */
+  bool erase(size_t id) {
+    Song song;
+    if (!get(id, song)) return false;
+
+    by_id_.erase(idKey(id));
+    by_year_.erase(yearKey(song));
+    by_play_count_.erase(playCountKey(song));
+    file_.header().records--;
+    return true;
+  }
+
+  /**
+   * @brief Menghapus seluruh lagu (file dikosongkan)
+   *
+   */
+  bool clear() {
+    pool_.discard();
+    return file_.reset();
+  }
+
+  /**
+   * @brief Menelusuri lagu dengan ID dalam rentang [first, last]
+   *
+   * @param visit Dipanggil dengan const Song&, berhenti jika mengembalikan
+   * false
+   */
+  template <typename Visitor>
+  void scanIds(size_t first, size_t last, Visitor visit,
+               bool descending = false) {
+    Song song;
+    by_id_.scan(
+        idKey(first), idKey(last),
+        [&](const BPlusTree::Key&, const char* record) {
+          return decode(record, song) && visit(static_cast<const Song&>(song));
+        },
+        descending);
+  }
+
+  /**
+   * @brief Menelusuri lagu dengan tahun rilis dalam rentang [first, last]
+   *
+   */
+  template <typename Visitor>
+  void scanYears(int first, int last, Visitor visit, bool descending = false) {
+    scanSecondary(by_year_, {yearColumn(first), 0},
+                  {yearColumn(last), UINT64_MAX}, visit, descending);
+  }
+
+  /**
+   * @brief Menelusuri ID lagu dengan tahun rilis dalam rentang [first, last]
+   *
+   * Hanya leaf tree tahun rilis yang dibaca, record lagu tidak dibaca.
+   *
+   * @param visit Dipanggil dengan ID lagu (size_t), terurut berdasarkan tahun
+   * lalu ID. Berhenti jika mengembalikan false.
+   */
+  template <typename Visitor>
+  void scanYearIds(int first, int last, Visitor visit) {
+    by_year_.scan({yearColumn(first), 0}, {yearColumn(last), UINT64_MAX},
+                  [&](const BPlusTree::Key& key, const char*) {
+                    return visit(static_cast<size_t>(key.minor));
+                  });
+  }
+
+  /**
+   * @brief Menelusuri lagu dengan jumlah pemutaran dalam rentang [low, high]
+   *
+   */
+  template <typename Visitor>
+  void scanPlayCounts(size_t low, size_t high, Visitor visit,
+                      bool descending = false) {
+    scanSecondary(by_play_count_, {low, 0}, {high, UINT64_MAX}, visit,
+                  descending);
+  }
+
+  /**
+   * @brief Menelusuri ID seluruh lagu terurut berdasarkan jumlah pemutaran
+   *
+   * Hanya leaf tree jumlah pemutaran yang dibaca, record lagu tidak dibaca.
+   *
+   * @param visit Dipanggil dengan ID lagu (size_t), berhenti jika
+   * mengembalikan false
+   */
+  template <typename Visitor>
+  void scanPlayCountIds(Visitor visit) {
+    by_play_count_.scan(BPlusTree::kMinKey, BPlusTree::kMaxKey,
+                        [&](const BPlusTree::Key& key, const char*) {
+                          return visit(static_cast<size_t>(key.minor));
+                        });
+  }
+
+  /**
+   * @return size_t ID terbesar dalam store (0 jika kosong)
+   */
+  size_t maxId() {
+    size_t id = 0;
+    by_id_.scan(
+        BPlusTree::kMinKey, BPlusTree::kMaxKey,
+        [&](const BPlusTree::Key& key, const char*) {
+          id = key.major;
+          return false;
+        },
+        true);
+    return id;
+  }
+
+  /**
+   * @brief Commit seluruh halaman yang berubah dan header ke file
+   *
+   */
+  bool flush() {
+    if (!file_.isOpen()) return true;
+    return pool_.flush() && file_.sync();
+  }
+
+  const BufferPool& pool() const { return pool_; }
+
+ private:
+  enum Tree { kIdTree, kYearTree, kPlayCountTree };
+
+  PageFile file_;               /**< File halaman */
+  BufferPool pool_;             /**< Cache halaman */
+  BPlusTree by_id_;             /**< Record lagu berdasarkan ID */
+  BPlusTree by_year_;           /**< Index (tahun rilis, ID) */
+  BPlusTree by_play_count_;     /**< Index (jumlah pemutaran, ID) */
+
+  static BPlusTree::Key idKey(size_t id) { return {id, 0}; }
+
+  // Tahun digeser agar tahun negatif tetap terurut sebagai unsigned
+  static uint64_t yearColumn(int year) {
+    return static_cast<uint64_t>(static_cast<int64_t>(year) +
+                                 (int64_t{1} << 32));
+  }
+  static BPlusTree::Key yearKey(const Song& song) {
+    return {yearColumn(song.release_year), song.id};
+  }
+  static BPlusTree::Key playCountKey(const Song& song) {
+    return {song.play_count, song.id};
+  }
+
+  static void encode(const Song& song, char* record) {
+    BufferWriter writer(record, Song::kRecordSize);
+    song.serialize(writer);
+  }
+
+  static bool decode(const char* record, Song& song) {
+    MemoryReader reader(record, Song::kRecordSize);
+    return song.deserialize(reader);
+  }
+
+  template <typename Visitor>
+  void scanSecondary(BPlusTree& tree, const BPlusTree::Key& first,
+                     const BPlusTree::Key& last, Visitor& visit,
+                     bool descending) {
+    // Kumpulkan ID per batch agar leaf index tidak di-pin selama lookup
+    std::vector<size_t> ids;
+    BPlusTree::Key from = first, to = last, cursor{};
+    while (true) {
+      ids.clear();
+      tree.scan(
+          from, to,
+          [&](const BPlusTree::Key& key, const char*) {
+            ids.push_back(key.minor);
+            cursor = key;
+            return ids.size() < kScanBatch;
+          },
+          descending);
+
+      Song song;
+      for (size_t id : ids) {
+        if (get(id, song) && !visit(static_cast<const Song&>(song))) return;
+      }
+      if (ids.size() < kScanBatch) return;
+
+      // Lanjut dari key setelah key terakhir yang sudah dikunjungi
+      if (descending) {
+        if (cursor == BPlusTree::kMinKey) return;
+        to = cursor.minor > 0 ? BPlusTree::Key{cursor.major, cursor.minor - 1}
+                              : BPlusTree::Key{cursor.major - 1, UINT64_MAX};
+      } else {
+        if (cursor == BPlusTree::kMaxKey) return;
+        from = cursor.minor < UINT64_MAX
+                   ? BPlusTree::Key{cursor.major, cursor.minor + 1}
+                   : BPlusTree::Key{cursor.major + 1, 0};
+      }
+    }
+  }
+
+  static constexpr size_t kScanBatch = 256; /**< ID per batch scan index */
+};
+
+/**
+ * @class SongCache
+ * @brief Cache record lagu berkapasitas tetap (LRU) di depan SongStore
+ *
+ * Record dibagi ke beberapa shard berdasarkan ID. Setiap shard memiliki lock
+ * dan daftar LRU sendiri, sehingga thread yang membaca lagu berbeda jarang
+ * saling menunggu. Slot disimpan dalam array dan dihubungkan lewat indeks.
+ * Setelah cache penuh, lagu yang paling lama tidak dipakai langsung ditimpa
+ * tanpa alokasi baru: slotnya ditimpa dan node tabel ID-nya dipakai ulang
+ * untuk lagu baru. Slot yang dikosongkan erase() melepas node tabelnya,
+ * sehingga pemakaian ulang slot tersebut mengalokasikan satu node.
+ */
+class SongCache {
+ public:
+  static constexpr size_t kShards = 16; /**< Jumlah shard (lock) */
+  static constexpr size_t kDefaultBudget =
+      8 * 1024 * 1024; /**< Batas memori default (byte) */
+
+  explicit SongCache(size_t budget = kDefaultBudget) { setBudget(budget); }
+  SongCache(const SongCache&) = delete;
+  SongCache& operator=(const SongCache&) = delete;
+
+  /**
+   * @brief Mengatur batas memori cache, isi cache dikosongkan
+   *
+   * @param budget Batas memori dalam byte (0: cache tidak dipakai)
+   */
+  void setBudget(size_t budget) {
+    size_t per_shard = budget / sizeof(Slot) / kShards;
+    for (Shard& shard : shards_) {
+      std::lock_guard<std::mutex> lock(shard.mutex);
+      shard.capacity = per_shard;
+      shard.reset();
+      shard.slots.shrink_to_fit();
+    }
+  }
+
+  /**
+   * @brief Mengambil salinan lagu dari cache
+   *
+   * Jika cache tidak dipakai (budget 0), statistik hit / miss tidak dicatat.
+   *
+   * @return true jika lagu ada di cache (hit)
+   */
+  bool get(size_t id, Song& song) {
+    Shard& shard = shardOf(id);
+    {
+      std::lock_guard<std::mutex> lock(shard.mutex);
+      if (shard.capacity == 0) return false;
+
+      auto cached = shard.index.find(id);
+      if (cached != shard.index.end()) {
+        shard.moveToFront(cached->second);
+        song = shard.slots[cached->second].song;
+        hits_.fetch_add(1, std::memory_order_relaxed);
+        RAIVFY_COUNT(kCacheHits, 1);
+        return true;
+      }
+    }
+
+    misses_.fetch_add(1, std::memory_order_relaxed);
+    RAIVFY_COUNT(kCacheMisses, 1);
+    return false;
+  }
+
+  /**
+   * @brief Menyimpan atau memperbarui lagu di cache
+   *
+   */
+  void put(const Song& song) {
+    Shard& shard = shardOf(song.id);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    if (shard.capacity == 0) return;
+
+    auto cached = shard.index.find(song.id);
+    if (cached != shard.index.end()) {
+      shard.slots[cached->second].song = song;
+      shard.moveToFront(cached->second);
+      return;
+    }
+
+    uint32_t slot;
+    Index::node_type node;
+    if (shard.slots.size() < shard.capacity) {
+      slot = static_cast<uint32_t>(shard.slots.size());
+      shard.slots.emplace_back();
+    } else {
+      // Node index milik lagu yang dikeluarkan dipakai ulang untuk lagu baru
+      slot = shard.tail;
+      shard.unlink(slot);
+      node = shard.index.extract(shard.slots[slot].song.id);
+    }
+
+    shard.slots[slot].song = song;
+    shard.pushFront(slot);
+    if (node) {
+      node.key() = song.id;
+      node.mapped() = slot;
+      shard.index.insert(std::move(node));
+    } else {
+      shard.index.emplace(song.id, slot);
+    }
+  }
+
+  /**
+   * @brief Mengeluarkan lagu dari cache (misalnya karena dihapus)
+   *
+   */
+  void erase(size_t id) {
+    Shard& shard = shardOf(id);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    auto cached = shard.index.find(id);
+    if (cached == shard.index.end()) return;
+
+    // Slot kosong dipindah ke ujung LRU agar dipakai lebih dulu
+    uint32_t slot = cached->second;
+    shard.index.erase(cached);
+    shard.unlink(slot);
+    shard.pushBack(slot);
+    shard.slots[slot].song.id = kFreeId;
+  }
+
+  void clear() {
+    for (Shard& shard : shards_) {
+      std::lock_guard<std::mutex> lock(shard.mutex);
+      shard.reset();
+    }
+  }
+
+  /**
+   * @return size_t Jumlah lagu yang berada di cache
+   */
+  size_t size() {
+    size_t total = 0;
+    for (Shard& shard : shards_) {
+      std::lock_guard<std::mutex> lock(shard.mutex);
+      total += shard.index.size();
+    }
+    return total;
+  }
+
+  size_t capacity() const { return shards_[0].capacity * kShards; }
+  uint64_t hits() const { return hits_.load(std::memory_order_relaxed); }
+  uint64_t misses() const { return misses_.load(std::memory_order_relaxed); }
+
+ private:
+  static constexpr uint32_t kNil = UINT32_MAX; /**< Penanda akhir daftar */
+  static constexpr size_t kFreeId = 0; /**< ID slot kosong (ID mulai dari 1) */
+  using Index = std::unordered_map<size_t, uint32_t>;
+
+  /**
+   * @brief Satu record di cache beserta tautan LRU-nya
+   *
+   */
+  struct Slot {
+    Song song;
+    uint32_t previous{kNil}; /**< Slot yang lebih baru dipakai */
+    uint32_t next{kNil};     /**< Slot yang lebih lama dipakai */
+  };
+
+  /**
+   * @brief Satu bagian cache dengan lock dan daftar LRU sendiri
+   *
+   */
+  struct Shard {
+    std::mutex mutex;
+    std::vector<Slot> slots; /**< Isi cache */
+    Index index;             /**< ID lagu ke slot */
+    uint32_t head{kNil};                        /**< Paling baru dipakai */
+    uint32_t tail{kNil};                        /**< Paling lama dipakai */
+    size_t capacity{0};                         /**< Jumlah slot maksimal */
+
+    void reset() {
+      slots.clear();
+      index.clear();
+      head = tail = kNil;
+    }
+
+    void unlink(uint32_t slot) {
+      Slot& entry = slots[slot];
+      if (entry.previous != kNil) {
+        slots[entry.previous].next = entry.next;
+      } else {
+        head = entry.next;
+      }
+      if (entry.next != kNil) {
+        slots[entry.next].previous = entry.previous;
+      } else {
+        tail = entry.previous;
+      }
+      entry.previous = entry.next = kNil;
+    }
+
+    void pushFront(uint32_t slot) {
+      slots[slot].next = head;
+      if (head != kNil) slots[head].previous = slot;
+      head = slot;
+      if (tail == kNil) tail = slot;
+    }
+
+    void pushBack(uint32_t slot) {
+      slots[slot].previous = tail;
+      if (tail != kNil) slots[tail].next = slot;
+      tail = slot;
+      if (head == kNil) head = slot;
+    }
+
+    void moveToFront(uint32_t slot) {
+      if (slot == head) return;
+      unlink(slot);
+      pushFront(slot);
+    }
+  };
+
+  std::array<Shard, kShards> shards_;     /**< Bagian cache */
+  std::atomic<uint64_t> hits_{0};         /**< Lagu ditemukan di cache */
+  std::atomic<uint64_t> misses_{0};       /**< Lagu harus dibaca dari store */
+
+  Shard& shardOf(size_t id) { return shards_[id % kShards]; }
+};
+
+/**
+ * @class SongLibrary
+ * @brief Kelas yang mengatur seluruh operasi terhadap Database Lagu
+ *
+ */
+class SongLibrary {
+ public:
+  /**
+   * @brief Mengambil data lagu yang ada di database
+   *
+   * Jika database memakai SongStore, isinya kosong: lagu tidak pernah dimuat
+   * seluruhnya ke memori. Gunakan view(), forEachSong(), atau findSong().
+   *
+   * @return ArrayList<Song>& Vector berisi lagu dalam database
+   */
+  ArrayList<Song>& database() { return database_; }
+
+  /**
+   * @brief Kolom pengurutan tampilan seluruh lagu
+   *
+   */
+  enum class SortColumn { kId, kTitle, kYear, kPlayCount };
+
+  /**
+   * @brief Membuat tampilan seluruh lagu terurut berdasarkan kolom
+   *
+   * Tanpa SongStore, tampilan menunjuk ke database di memori. Dengan
+   * SongStore, tampilan hanya berisi ID lagu dan setiap baris dibaca melalui
+   * findSong() saat ditampilkan. Urutan ID, tahun rilis, dan jumlah
+   * pemutaran dibaca dari tree store, urutan judul membutuhkan judul seluruh
+   * lagu selama pengurutan saja.
+   *
+   * @param column Kolom pengurutan
+   * @param descending Urutan menurun
+   */
+  SongView view(SortColumn column = SortColumn::kId,
+                bool descending = false) {
+    if (!store_) {
+      ensureSortedById();
+      SongView view(database_);
+      if (column == SortColumn::kId && !descending) return view;
+
+      std::function<bool(const Song&, const Song&)> comparator =
+          SongSorter::by_id;
+      if (column == SortColumn::kTitle) {
+        comparator = SongSorter::by_title;
+      } else if (column == SortColumn::kYear) {
+        comparator = SongSorter::by_release_year;
+      } else if (column == SortColumn::kPlayCount) {
+        comparator = SongSorter::by_play_count;
+      }
+      if (descending) comparator = SongSorter::reverseOrder<Song>(comparator);
+      view.sortBy(comparator);
+      return view;
+    }
+
+    std::vector<size_t> ids;
+    ids.reserve(size());
+    auto collect = [&ids](size_t id) {
+      ids.push_back(id);
+      return true;
+    };
+    if (column == SortColumn::kYear) {
+      scanYearIds(LLONG_MIN, LLONG_MAX, collect);
+    } else if (column == SortColumn::kPlayCount) {
+      store_->scanPlayCountIds(collect);
+    } else if (column == SortColumn::kTitle) {
+      std::vector<std::pair<std::string, size_t>> titles;
+      titles.reserve(size());
+      forEachSong([&titles](const Song& song) {
+        titles.emplace_back(song.title, song.id);
+        return true;
+      });
+      std::stable_sort(titles.begin(), titles.end(),
+                       [](const auto& a, const auto& b) {
+                         return a.first < b.first;
+                       });
+      for (const auto& title : titles) ids.push_back(title.second);
+    } else {
+      forEachSong([&ids](const Song& song) {
+        ids.push_back(song.id);
+        return true;
+      });
+    }
+    if (descending) std::reverse(ids.begin(), ids.end());
+
+    return SongView(std::move(ids), [this](size_t id, Song& song) {
+      return findSong(id, song);
+    });
+  }
+
+  /**
+   * @brief Menjalankan database di atas SongStore (B+-tree di disk)
+   *
+   * Store menjadi sumber data utama, isi database di memori dikosongkan.
+   *
+   * @param store Store yang sudah dibuka
+   */
+  void attachStore(SongStore& store) {
+    store_ = &store;
+    database_ = ArrayList<Song>();
+    cache_.clear();
+    reindex();
+  }
+
+  /**
+   * @brief Cache record lagu yang dipakai bersama SongStore
+   *
+   */
+  SongCache& cache() { return cache_; }
+
+  static constexpr size_t kDefaultIndexBudget =
+      64 * 1024 * 1024; /**< Batas memori index default (byte) */
+
+  /**
+   * @return true jika database memakai SongStore
+   */
+  bool usesStore() const { return store_ != nullptr; }
+
+  /**
+   * @brief Mengatur batas memori index yang tetap di memori saat memakai
+   * SongStore
+   *
+   * Dengan SongStore, tahun rilis dan dekade dilayani tree tahun rilis di
+   * disk. Yang tetap di memori adalah index durasi (16 byte per lagu) serta
+   * bitmap genre, artis, dan seluruh ID (sekitar 2 byte per lagu per
+   * bitmap), diperkirakan kIndexBytesPerSong per lagu. Jika perkiraan
+   * melewati batas, index tersebut tidak dibangun dan query memakai scan.
+   * Tanpa SongStore batas ini tidak berlaku, karena seluruh lagu memang
+   * berada di memori.
+   *
+   * @param budget Batas memori dalam byte
+   */
+  void setIndexBudget(size_t budget) {
+    index_budget_ = budget;
+    if (!hasMemoryIndexes()) dropIndexes();
+  }
+
+  /**
+   * @return true jika index durasi dan bitmap genre / artis tersedia
+   */
+  bool hasMemoryIndexes() {
+    return !store_ || size() <= index_budget_ / kIndexBytesPerSong;
+  }
+
+  /**
+   * @return size_t Jumlah lagu dalam database
+   */
+  size_t size() { return store_ ? store_->size() : database_.size(); }
+
+  /**
+   * @brief Mengambil salinan lagu berdasarkan ID
+   *
+   * @param id ID lagu
+   * @param song Tempat menyimpan lagu yang ditemukan
+   * @return true jika lagu ditemukan
+   */
+  bool findSong(size_t id, Song& song) {
+    if (store_) {
+      if (cache_.get(id, song)) return true;
+      if (!store_->get(id, song)) return false;
+
+      cache_.put(song);
+      return true;
+    }
+
+    const Song* found = lowerBoundById(id);
+    if (found == database_.arr + database_.size() || found->id != id) {
+      return false;
+    }
+
+    song = *found;
+    return true;
+  }
+
+  /**
+   * @brief Menelusuri seluruh lagu berurutan berdasarkan ID
+   *
+   * @param visit Dipanggil dengan const Song&, berhenti jika mengembalikan
+   * false
+   */
+  template <typename Visitor>
+  void forEachSong(Visitor visit) {
+    if (store_) {
+      store_->scanIds(0, SIZE_MAX, visit);
+      return;
+    }
+
+    for (size_t i = 0; i < database_.size(); i++) {
+      if (!visit(static_cast<const Song&>(database_.arr[i]))) return;
+    }
+  }
+
+  /**
+   * @brief Kolom yang dapat dipakai untuk range scan
+   *
+   */
+  enum class RangeColumn { kId, kYear, kDuration, kPlayCount };
+
+  /**
+   * @brief Menelusuri lagu dengan nilai kolom dalam rentang [low, high],
+   * terurut berdasarkan kolom tersebut lalu ID
+   *
+   * Tahun rilis dan durasi memakai OrderedIndex (O(log n + k)), ID memakai
+   * urutan database. Dengan SongStore, ID, tahun rilis, dan jumlah pemutaran
+   * memakai B+-tree store, durasi memakai OrderedIndex selama masih dalam
+   * batas index (lihat setIndexBudget()). Kolom tanpa index disaring lalu
+   * diurutkan.
+   */
+  template <typename Visitor>
+  void scanRange(RangeColumn column, long long low, long long high,
+                 Visitor visit) {
+    if (low > high) return;
+
+    if (store_ && column != RangeColumn::kDuration) {
+      if (column == RangeColumn::kYear) {
+        store_->scanYears(clampYear(low), clampYear(high), visit);
+        return;
+      }
+
+      if (high < 0) return;
+      size_t first = static_cast<size_t>(std::max(0LL, low));
+      size_t last = static_cast<size_t>(high);
+      if (column == RangeColumn::kId) {
+        store_->scanIds(first, last, visit);
+      } else {
+        store_->scanPlayCounts(first, last, visit);
+      }
+      return;
+    }
+
+    if (column == RangeColumn::kDuration && !hasMemoryIndexes()) {
+      std::vector<Song> matches;
+      forEachSong([&](const Song& song) {
+        long long duration = static_cast<long long>(song.duration);
+        if (duration >= low && duration <= high) matches.push_back(song);
+        return true;
+      });
+      std::stable_sort(matches.begin(), matches.end(),
+                       [](const Song& a, const Song& b) {
+                         return a.duration < b.duration;
+                       });
+      for (const Song& song : matches) {
+        if (!visit(song)) return;
+      }
+      return;
+    }
+
+    if (column == RangeColumn::kYear || column == RangeColumn::kDuration) {
+      Song song;
+      index(column).scan(low, high, [&](const OrderedIndex::Entry& entry) {
+        if (store_) {
+          return !findSong(entry.id, song) ||
+                 visit(static_cast<const Song&>(song));
+        }
+
+        const Song* found = lowerBoundById(entry.id);
+        return found == database_.arr + database_.size() ||
+               found->id != entry.id || visit(*found);
+      });
+      return;
+    }
+
+    if (column == RangeColumn::kId) {
+      if (high < 0) return;
+      const Song* song =
+          lowerBoundById(static_cast<size_t>(std::max(0LL, low)));
+      const Song* end = database_.arr + database_.size();
+      for (; song != end && song->id <= static_cast<size_t>(high); song++) {
+        if (!visit(*song)) return;
+      }
+      return;
+    }
+
+    std::vector<const Song*> matches;
+    for (size_t i = 0; i < database_.size(); i++) {
+      long long plays = static_cast<long long>(database_.arr[i].play_count);
+      if (plays >= low && plays <= high) matches.push_back(&database_.arr[i]);
+    }
+    std::stable_sort(matches.begin(), matches.end(),
+                     [](const Song* a, const Song* b) {
+                       return a->play_count < b->play_count;
+                     });
+    for (const Song* song : matches) {
+      if (!visit(*song)) return;
+    }
+  }
+
+  /**
+   * @brief Menghitung lagu dengan nilai kolom dalam rentang [low, high]
+   *
+   * Tahun rilis dan durasi cukup O(log n) dari OrderedIndex, kolom lain
+   * dihitung dengan range scan. Dengan SongStore, tahun rilis dihitung dari
+   * leaf tree tahun rilis (O(log n + k)) tanpa index di memori.
+   */
+  size_t countRange(RangeColumn column, long long low, long long high) {
+    if (store_ && column == RangeColumn::kYear) {
+      size_t count = 0;
+      scanYearIds(low, high, [&count](size_t) {
+        count++;
+        return true;
+      });
+      return count;
+    }
+    if (hasOrderedIndex(column)) return index(column).count(low, high);
+    if (column == RangeColumn::kId && !store_) {
+      if (low > high || high < 0) return 0;
+      return static_cast<size_t>(
+          lowerBoundById(static_cast<size_t>(high) + 1) -
+          lowerBoundById(static_cast<size_t>(std::max(0LL, low))));
+    }
+
+    size_t count = 0;
+    scanRange(column, low, high, [&count](const Song&) {
+      count++;
+      return true;
+    });
+    return count;
+  }
+
+  /**
+   * @brief Mengambil ID lagu dengan nilai kolom dalam rentang [low, high]
+   *
+   * @param ids Tujuan, ID ditambahkan terurut berdasarkan kolom (bukan ID)
+   */
+  void collectIds(RangeColumn column, long long low, long long high,
+                  std::vector<size_t>& ids) {
+    if (store_ && column == RangeColumn::kYear) {
+      scanYearIds(low, high, [&ids](size_t id) {
+        ids.push_back(id);
+        return true;
+      });
+      return;
+    }
+
+    if (hasOrderedIndex(column)) {
+      index(column).scan(low, high, [&ids](const OrderedIndex::Entry& entry) {
+        ids.push_back(entry.id);
+        return true;
+      });
+      return;
+    }
+
+    scanRange(column, low, high, [&ids](const Song& song) {
+      ids.push_back(song.id);
+      return true;
+    });
+  }
+
+  /**
+   * @brief Kolom teks yang memiliki bitmap index
+   *
+   */
+  enum class TextColumn { kGenre, kArtist };
+
+  /**
+   * @brief Mengambil bitmap ID lagu untuk satu nilai kolom
+   *
+   * Hanya tersedia jika hasMemoryIndexes().
+   *
+   * @param value Nilai yang dicari, tidak membedakan huruf besar / kecil
+   * @return const RoaringBitmap& ID lagu dengan nilai tersebut
+   */
+  const RoaringBitmap& bitmap(TextColumn column, const std::string& value) {
+    static const RoaringBitmap kEmpty;
+    BitmapMap& map = bitmapMap(column);
+    auto found = map.find(SongSearcher::normalizeString(value.c_str()));
+    return found != map.end() ? found->second : kEmpty;
+  }
+
+  /**
+   * @brief Menggabungkan (OR) bitmap dekade rilis dalam rentang [low, high]
+   *
+   * Dengan SongStore, ID diambil dari tree tahun rilis sehingga tidak ada
+   * bitmap dekade yang disimpan di memori.
+   *
+   * @param low Dekade pertama (misalnya 1990)
+   * @param high Dekade terakhir (misalnya 2010)
+   */
+  RoaringBitmap decades(long long low, long long high) {
+    if (store_) {
+      std::vector<size_t> ids;
+      collectIds(RangeColumn::kYear, low, std::min(high, LLONG_MAX - 9) + 9,
+                 ids);
+      std::sort(ids.begin(), ids.end());
+
+      RoaringBitmap result;
+      for (size_t id : ids) result.add(id);
+      return result;
+    }
+
+    buildIndexes();
+    RoaringBitmap result;
+    for (auto decade = decade_bitmaps_.lower_bound(low);
+         decade != decade_bitmaps_.end() && decade->first <= high; decade++) {
+      result |= decade->second;
+    }
+    return result;
+  }
+
+  /**
+   * @brief Bitmap seluruh ID lagu (dipakai untuk NOT)
+   *
+   * Hanya tersedia jika hasMemoryIndexes().
+   */
+  const RoaringBitmap& allSongs() {
+    buildIndexes();
+    return all_songs_;
+  }
+
+  /**
+   * @brief Dekade rilis sebuah tahun (misalnya 2017 -> 2010)
+   *
+   */
+  static long long decadeOf(long long year) {
+    return (year >= 0 ? year : year - 9) / 10 * 10;
+  }
+
+  /**
+   * @brief Menghapus seluruh lagu dari database
+   *
+   */
+  void clear() {
+    database_.clear();
+    cache_.clear();
+    if (store_) store_->clear();
+    reindex();
+    markDirty();
+  }
+
+  /**
+   * @brief Membangun ulang seluruh struktur turunan database
+   *
+   * Dipanggil setelah isi database diganti secara keseluruhan, misalnya
+   * setelah dimuat dari file atau setelah impor massal. Database diurutkan
+   * berdasarkan ID (hanya diperiksa jika sudah terurut) dan id_counter
+   * dipastikan lebih besar dari ID terbesar.
+   */
+  void reindex() {
+    SongSorter::ensureSortedByID(database_);
+    sorted_by_id_ = true;
+    dropIndexes();
+    if (store_) {
+      Song::id_counter = std::max(Song::id_counter.load(), store_->maxId() + 1);
+    } else if (!database_.empty()) {
+      Song::id_counter = std::max(Song::id_counter.load(),
+                                  database_.arr[database_.size() - 1].id + 1);
+    }
+
+    rebuildTopPlayed();
+    invalidateCatalog();
+  }
+
+  /**
+   * @brief Menambahkan lagu tanpa cek duplikat dan tanpa memperbarui index
+   *
+   * Untuk penambahan massal, reindex() wajib dipanggil sekali setelah seluruh
+   * lagu ditambahkan.
+   *
+   * @param song Lagu yang akan ditambahkan
+   * @return false jika lagu gagal ditulis ke SongStore
+   */
+  bool appendUnindexed(const Song& song) {
+    if (store_) {
+      if (!store_->put(song)) return false;
+      cache_.erase(song.id);
+    }
+    if (!store_) {
+      database_.add(song);
+      sorted_by_id_ = false;
+    }
+    return true;
+  }
+
+  /**
+   * @brief Nomor versi isi database, naik setiap kali snapshot catalog()
+   * usang
+   *
+   * Perubahan jumlah pemutaran tidak menaikkan versi.
+   */
+  size_t catalogVersion() const { return catalog_version_; }
+
+  /**
+   * @brief Mengambil snapshot metadata lagu-lagu tertentu untuk thread
+   * pemutar
+   *
+   * Metadata dicari dengan findSong() hanya untuk lagu yang diminta
+   * (misalnya isi playlist yang sedang diputar), sehingga ukuran snapshot
+   * tidak bergantung pada jumlah lagu di database. Pemanggil cukup
+   * membangun ulang snapshot jika catalogVersion() berubah.
+   *
+   * @param songs Lagu yang metadatanya dibutuhkan
+   * @return std::shared_ptr<const CatalogSnapshot> Snapshot metadata
+   */
+  std::shared_ptr<const CatalogSnapshot> catalog(
+      const IndexedList<Song>& songs) {
+    auto catalog = std::make_shared<CatalogSnapshot>();
+    catalog->tracks.reserve(songs.count());
+    Song song;
+    for (auto* node = songs.head(); node; node = node->next) {
+      if (findSong(node->data.id, song)) {
+        catalog->tracks.push_back({song.id, song.title, song.duration});
+      }
+    }
+
+    std::sort(catalog->tracks.begin(), catalog->tracks.end(),
+              [](const TrackInfo& a, const TrackInfo& b) {
+                return a.id < b.id;
+              });
+    catalog->tracks.erase(
+        std::unique(catalog->tracks.begin(), catalog->tracks.end(),
+                    [](const TrackInfo& a, const TrackInfo& b) {
+                      return a.id == b.id;
+                    }),
+        catalog->tracks.end());
+    return catalog;
+  }
+
+  /**
+   * @brief Menambahkan lagu ke dalam database
+   *
+   * @param song Data yang akan ditambahkan
+   * @return false jika lagu gagal ditulis ke SongStore
+   */
+  bool addToLibrary(Song song) {
+    ensureSortedById();
+    if (store_) {
+      Song existing;
+      if (!store_->get(song.id, existing)) {
+        if (!store_->put(song)) return false;
+        updateTopPlayed(song);
+        updateIndexes(song, true);
+        invalidateCatalog();
+      }
+    } else if (!SongSearcher::binarySearchSorted(song.id, database_)) {
+      appendSorted(song);
+      updateTopPlayed(song);
+      updateIndexes(song, true);
+      invalidateCatalog();
+    }
+
+    markDirty();
+    return true;
+  }
+
+  /**
+   * @brief Menghubungkan database dengan thread penyimpanan
+   *
+   * @param persistence Thread penyimpanan tujuan snapshot database
+   * @param filename File database
+   */
+  void attach(PersistenceWorker& persistence, std::string filename) {
+    persistence_ = &persistence;
+    filename_ = std::move(filename);
+  }
+
+  /**
+   * @brief Menandai database berubah dan perlu disimpan
+   *
+   * Dipanggil otomatis oleh addToLibrary() dan removeSongById(). Perubahan
+   * lain (impor massal, jumlah pemutaran) memanggilnya sekali setelah
+   * seluruh perubahan diterapkan. Database baru disimpan oleh persist().
+   */
+  void markDirty() { dirty_ = true; }
+
+  /**
+   * @brief Menyimpan database jika ada perubahan sejak persist() terakhir
+   *
+   * Tanpa SongStore, snapshot database dikirim ke thread penyimpanan sekali
+   * untuk seluruh perubahan sejak pemanggilan sebelumnya. Database tetap
+   * ditandai berubah jika commit SongStore atau penulisan snapshot gagal.
+   *
+   * @return false jika commit SongStore gagal
+   */
+  bool persist() {
+    if (persistence_ && persistence_->takeFailure(filename_)) dirty_ = true;
+    if (!dirty_) return true;
+
+    // SongStore cukup menulis halaman yang berubah, bukan seluruh database
+    if (store_) {
+      if (!store_->flush()) {
+        std::cerr << "Gagal menyimpan SongStore!\n";
+        return false;
+      }
+    } else if (persistence_) {
+      persistence_->schedule(filename_, database_);
+    }
+    dirty_ = false;
+    return true;
+  }
+
+  /**
+   * @brief Menambahkan jumlah pemutaran beberapa lagu sekaligus
+   *
+   * Seluruh database ditelusuri satu kali, urutan database tidak berubah.
+   *
+   * @param counts Tabel ID lagu ke jumlah pemutaran tambahan
+   * @return size_t Jumlah lagu yang diperbarui
+   */
+  size_t applyPlayCounts(const std::unordered_map<size_t, size_t>& counts) {
+    size_t updated = 0;
+
+    if (store_) {
+      Song song;
+      for (const auto& count : counts) {
+        if (!findSong(count.first, song)) continue;
+        song.play_count += count.second;
+        if (!store_->put(song)) {
+          std::cerr << "Gagal menyimpan lagu " << song.id << " ke SongStore!\n";
+          continue;
+        }
+        cache_.put(song);
+        updateTopPlayed(song);
+        updated++;
+      }
+      return updated;
+    }
+
+    for (size_t i = 0; i < database_.size() && updated < counts.size(); i++) {
+      auto count = counts.find(database_.arr[i].id);
+      if (count == counts.end()) continue;
+
+      database_.arr[i].play_count += count->second;
+      updateTopPlayed(database_.arr[i]);
+      updated++;
+    }
+
+    return updated;
+  }
+
+  /**
+   * @brief Mengambil lagu yang paling sering diputar
+   *
+   * @return const std::vector<PlayRank>& Peringkat lagu, terbanyak di depan
+   */
+  const std::vector<PlayRank>& topPlayed() const { return top_played_; }
+
+  /**
+   * @brief Menghapus lagu dari database berdasarkan ID
+   *
+   * @param target_id ID lagu yang akan dihapus
+   */
+  void removeSongById(size_t target_id) {
+    Song removed;
+    if (indexed_ && findSong(target_id, removed)) updateIndexes(removed, false);
+    cache_.erase(target_id);
+    if (store_) {
+      if (!store_->erase(target_id)) return;
+      rebuildTopPlayed();
+      invalidateCatalog();
+      markDirty();
+      return;
+    }
+
+    ensureSortedById();
+    if (SongSearcher::binarySearchSorted(target_id, database_)) {
+      for (size_t i = 0; i < database_.size(); i++) {
+        if (database_.arr[i].id == target_id) {
+          for (size_t j = i; j < database_.size() - 1; j++) {
+            database_.arr[j] = database_.arr[j + 1];
+          }
+          database_.decreaseSize();
+          break;
+        }
+      }
+      rebuildTopPlayed();
+      invalidateCatalog();
+      markDirty();
+    }
+  }
+
+  /**
+   * @brief Mengambil data dari database berdasarkan ID
+   *
+   * @param target_id ID lagu yang akan diambil
+   * @return Song& Referensi Lagu dari hasil pencarian
+   */
+  Song& getSongById(int target_id) {
+    ensureSortedById();
+    if (SongSearcher::binarySearchSorted(target_id, database_)) {
+      int result = SongSearcher::result_index;
+      SongSearcher::result_index = -1;
+      return database_.arr[result];
+    }
+  }
+
+ private:
+  static constexpr size_t kTopPlayed = 5; /**< Jumlah lagu terpopuler */
+  static constexpr size_t kIndexBytesPerSong =
+      24; /**< Perkiraan memori index di memori per lagu */
+
+  ArrayList<Song>
+      database_; /**< Vector berisi seluruh lagu yang ada (database) */
+  std::vector<PlayRank> top_played_; /**< Top-K lagu paling sering diputar */
+  PersistenceWorker* persistence_{nullptr}; /**< Thread penyimpanan */
+  std::string filename_;                    /**< File database */
+  SongStore* store_{nullptr}; /**< Store di disk (null: seluruhnya di memori) */
+  bool sorted_by_id_{true};   /**< database_ terurut berdasarkan ID */
+  bool dirty_{false};         /**< Ada perubahan yang belum disimpan */
+  SongCache cache_;           /**< Lagu yang sering dibaca dari store */
+  using BitmapMap = std::unordered_map<std::string, RoaringBitmap>;
+
+  OrderedIndex year_index_;     /**< Index tahun rilis */
+  OrderedIndex duration_index_; /**< Index durasi */
+  BitmapMap genre_bitmaps_;     /**< Genre (huruf kecil) ke ID lagu */
+  BitmapMap artist_bitmaps_;    /**< Artis (huruf kecil) ke ID lagu */
+  std::map<long long, RoaringBitmap> decade_bitmaps_; /**< Dekade ke ID */
+  RoaringBitmap all_songs_;     /**< Seluruh ID lagu */
+  bool indexed_{false};         /**< Seluruh index sudah dibangun */
+  size_t index_budget_{kDefaultIndexBudget}; /**< Batas index (SongStore) */
+  size_t catalog_version_{0}; /**< Naik setiap kali isi database berubah */
+
+  void invalidateCatalog() { catalog_version_++; }
+
+  /**
+   * @brief Memperbarui posisi lagu pada daftar top-K
+   *
+   * Jumlah pemutaran hanya bertambah, sehingga cukup memperbarui lagu yang
+   * berubah tanpa menelusuri ulang seluruh database.
+   */
+  void updateTopPlayed(const Song& song) {
+    auto existing = std::find_if(
+        top_played_.begin(), top_played_.end(),
+        [&song](const PlayRank& rank) { return rank.id == song.id; });
+    if (existing != top_played_.end()) top_played_.erase(existing);
+
+    PlayRank rank{song.id, song.play_count, song.title};
+    auto position = std::upper_bound(
+        top_played_.begin(), top_played_.end(), rank,
+        [](const PlayRank& a, const PlayRank& b) {
+          return a.play_count > b.play_count;
+        });
+    top_played_.insert(position, rank);
+
+    if (top_played_.size() > kTopPlayed) top_played_.pop_back();
+  }
+
+  /**
+   * @brief Mengambil index kolom, membangunnya dulu jika belum ada
+   *
+   * Index baru dibangun saat pertama kali dipakai agar memuat database dan
+   * perintah yang tidak memerlukannya tidak bertambah lambat.
+   */
+  OrderedIndex& index(RangeColumn column) {
+    buildIndexes();
+    return column == RangeColumn::kYear ? year_index_ : duration_index_;
+  }
+
+  BitmapMap& bitmapMap(TextColumn column) {
+    buildIndexes();
+    return column == TextColumn::kGenre ? genre_bitmaps_ : artist_bitmaps_;
+  }
+
+  /**
+   * @brief Mengecek apakah range kolom dilayani OrderedIndex di memori
+   *
+   */
+  bool hasOrderedIndex(RangeColumn column) {
+    if (column == RangeColumn::kYear) return !store_;
+    return column == RangeColumn::kDuration && hasMemoryIndexes();
+  }
+
+  /**
+   * @brief Menelusuri ID lagu dari tree tahun rilis store
+   *
+   */
+  template <typename Visitor>
+  void scanYearIds(long long low, long long high, Visitor visit) {
+    if (low > high) return;
+    store_->scanYearIds(clampYear(low), clampYear(high), visit);
+  }
+
+  /**
+   * @brief Membangun index di memori
+   *
+   * Dengan SongStore, tahun rilis dan dekade tidak di-index karena sudah
+   * dilayani tree tahun rilis, dan index lain tidak dibangun jika melewati
+   * batas index.
+   */
+  void buildIndexes() {
+    if (indexed_ || !hasMemoryIndexes()) return;
+
+    std::vector<OrderedIndex::Entry> years, durations;
+    years.reserve(store_ ? 0 : size());
+    durations.reserve(size());
+    clearBitmaps();
+    // Lagu ditelusuri berurutan berdasarkan ID, sehingga bitmap cukup
+    // menambahkan anggota di akhir container
+    forEachSong([&](const Song& song) {
+      if (!store_) years.push_back({song.release_year, song.id});
+      durations.push_back({static_cast<long long>(song.duration), song.id});
+      updateBitmaps(song, true);
+      return true;
+    });
+    year_index_.build(std::move(years));
+    duration_index_.build(std::move(durations));
+    indexed_ = true;
+  }
+
+  void updateIndexes(const Song& song, bool added) {
+    if (!indexed_) return;
+    if (!hasMemoryIndexes()) {
+      // Database melewati batas index, index di memori dilepas
+      dropIndexes();
+      return;
+    }
+
+    long long duration = static_cast<long long>(song.duration);
+    if (added) {
+      if (!store_) year_index_.insert(song.release_year, song.id);
+      duration_index_.insert(duration, song.id);
+    } else {
+      if (!store_) year_index_.erase(song.release_year, song.id);
+      duration_index_.erase(duration, song.id);
+    }
+    updateBitmaps(song, added);
+  }
+
+  void updateBitmaps(const Song& song, bool added) {
+    RoaringBitmap* bitmaps[] = {
+        &genre_bitmaps_[SongSearcher::normalizeString(song.genre)],
+        &artist_bitmaps_[SongSearcher::normalizeString(song.artist)],
+        &all_songs_,
+        store_ ? nullptr : &decade_bitmaps_[decadeOf(song.release_year)]};
+    for (RoaringBitmap* bitmap : bitmaps) {
+      if (!bitmap) continue;
+      if (added) {
+        bitmap->add(song.id);
+      } else {
+        bitmap->remove(song.id);
+      }
+    }
+  }
+
+  void clearBitmaps() {
+    genre_bitmaps_.clear();
+    artist_bitmaps_.clear();
+    decade_bitmaps_.clear();
+    all_songs_.clear();
+  }
+
+  /**
+   * @brief Melepas seluruh index di memori, dibangun ulang saat dipakai
+   *
+   */
+  void dropIndexes() {
+    indexed_ = false;
+    year_index_ = OrderedIndex();
+    duration_index_ = OrderedIndex();
+    clearBitmaps();
+  }
+
+  /**
+   * @brief Memastikan database_ terurut berdasarkan ID
+   *
+   * Hanya memeriksa flag (O(1)). Urutan diperiksa ulang hanya setelah
+   * appendUnindexed() yang belum diikuti reindex().
+   */
+  void ensureSortedById() {
+    if (sorted_by_id_) return;
+    SongSorter::ensureSortedByID(database_);
+    sorted_by_id_ = true;
+  }
+
+  /**
+   * @brief Menambahkan lagu ke database_ dengan tetap terurut berdasarkan ID
+   *
+   * ID baru biasanya lebih besar dari ID terakhir sehingga cukup ditambahkan
+   * di akhir. Jika tidak, lagu digeser ke posisinya (insertion).
+   */
+  void appendSorted(const Song& song) {
+    database_.add(song);
+    size_t i = database_.size() - 1;
+    while (i > 0 && database_.arr[i - 1].id > song.id) {
+      database_.arr[i] = database_.arr[i - 1];
+      i--;
+    }
+    database_.arr[i] = song;
+  }
+
+  /**
+   * @brief Mencari lagu pertama dengan ID >= id
+   *
+   * database_ selalu terurut berdasarkan ID (dijaga oleh reindex() dan
+   * appendSorted()), sehingga tidak perlu diperiksa ulang di sini.
+   */
+  const Song* lowerBoundById(size_t id) const {
+    return std::lower_bound(
+        database_.arr, database_.arr + database_.size(), id,
+        [](const Song& song, size_t target) { return song.id < target; });
+  }
+
+  static int clampYear(long long year) {
+    return static_cast<int>(std::min<long long>(
+        std::max<long long>(year, INT_MIN), INT_MAX));
+  }
+
+  void rebuildTopPlayed() {
+    top_played_.clear();
+    if (store_) {
+      store_->scanPlayCounts(
+          0, SIZE_MAX,
+          [this](const Song& song) {
+            updateTopPlayed(song);
+            return top_played_.size() < kTopPlayed;
+          },
+          true);
+      return;
+    }
+
+    for (size_t i = 0; i < database_.size(); i++) {
+      updateTopPlayed(database_.arr[i]);
+    }
+  }
+};
+
+/**
+ * @class SongQuery
+ * @brief Gabungan beberapa predikat (AND) untuk QueryEngine
+ *
+ * Predikat teks (judul, artis, genre) dicocokkan secara utuh tanpa
+ * membedakan huruf besar / kecil, sama seperti SongSearcher, dan dapat
+ * berisi beberapa nilai (OR). Predikat angka berupa rentang [low, high],
+ * dekade memakai tahun awal dekade (2010 = 2010-2019). Setiap predikat
+ * dapat dinegasikan (NOT).
+ */
+class SongQuery {
+ public:
+  /**
+   * @brief Kolom lagu yang dapat difilter
+   *
+   */
+  enum class Field {
+    kId,
+    kTitle,
+    kArtist,
+    kGenre,
+    kYear,
+    kDecade,
+    kDuration,
+    kPlays
+  };
+
+  /**
+   * @brief Satu predikat
+   *
+   */
+  struct Predicate {
+    Field field;
+    std::vector<std::string> values; /**< Nilai predikat teks (huruf kecil) */
+    long long low{LLONG_MIN};        /**< Batas bawah predikat angka */
+    long long high{LLONG_MAX};       /**< Batas atas predikat angka */
+    bool negated{false};             /**< NOT */
+
+    bool isText() const {
+      return field == Field::kTitle || field == Field::kArtist ||
+             field == Field::kGenre;
+    }
+
+    bool matches(const Song& song) const { return test(song) != negated; }
+
+   private:
+    bool test(const Song& song) const {
+      switch (field) {
+        case Field::kTitle:
+          return equalsAny(song.title);
+        case Field::kArtist:
+          return equalsAny(song.artist);
+        case Field::kGenre:
+          return equalsAny(song.genre);
+        case Field::kYear:
+          return inRange(song.release_year);
+        case Field::kDecade:
+          return inRange(SongLibrary::decadeOf(song.release_year));
+        case Field::kDuration:
+          return inRange(static_cast<long long>(song.duration));
+        case Field::kPlays:
+          return inRange(static_cast<long long>(song.play_count));
+        default:
+          return inRange(static_cast<long long>(song.id));
+      }
+    }
+
+    bool inRange(long long value) const {
+      return value >= low && value <= high;
+    }
+
+    bool equalsAny(const char* value) const {
+      for (const std::string& text : values) {
+        if (equalsIgnoreCase(value, text)) return true;
+      }
+      return false;
+    }
+
+    // Dibandingkan per karakter agar fused scan tidak membuat string baru
+    static bool equalsIgnoreCase(const char* value, const std::string& text) {
+      size_t i = 0;
+      for (; value[i] != '\0'; i++) {
+        if (i == text.size() ||
+            std::tolower(static_cast<unsigned char>(value[i])) !=
+                static_cast<unsigned char>(text[i])) {
+          return false;
+        }
+      }
+      return i == text.size();
+    }
+  };
+
+  /**
+   * @brief Menambahkan predikat kesamaan teks (field = value)
+   *
+   */
+  SongQuery& where(Field field, const std::string& value) {
+    return whereAny(field, {value});
+  }
+
+  /**
+   * @brief Menambahkan predikat teks dengan beberapa nilai (OR)
+   *
+   * @param negated true untuk field tidak sama dengan seluruh nilai
+   */
+  SongQuery& whereAny(Field field, const std::vector<std::string>& values,
+                      bool negated = false) {
+    Predicate predicate{field, {}};
+    for (const std::string& value : values) {
+      predicate.values.push_back(SongSearcher::normalizeString(value.c_str()));
+    }
+    predicate.negated = negated;
+    predicates_.push_back(predicate);
+    return *this;
+  }
+
+  /**
+   * @brief Menambahkan predikat rentang angka (low <= field <= high)
+   *
+   * @param negated true untuk field di luar rentang
+   */
+  SongQuery& whereRange(Field field, long long low, long long high,
+                        bool negated = false) {
+    if (field == Field::kDecade) {
+      if (low != LLONG_MIN) low = SongLibrary::decadeOf(low);
+      if (high != LLONG_MAX) high = SongLibrary::decadeOf(high);
+    }
+
+    Predicate predicate{field, {}, low, high, negated};
+    predicates_.push_back(predicate);
+    return *this;
+  }
+
+  /**
+   * @brief Membaca satu predikat dari teks "kolom=nilai" atau "kolom!=nilai"
+   *
+   * Kolom teks menerima beberapa nilai dipisah koma (OR). Kolom angka
+   * menerima "nilai", "min..max", "min.." atau "..max".
+   *
+   * @param term Teks predikat, misalnya genre=pop,rock atau year=2010..2015
+   * @param error Pesan kesalahan jika teks tidak valid
+   * @return true jika predikat berhasil ditambahkan
+   */
+  bool parse(const std::string& term, std::string& error) {
+    size_t equals = term.find('=');
+    bool negated = equals != std::string::npos && equals > 0 &&
+                   term[equals - 1] == '!';
+    size_t name_end = negated ? equals - 1 : equals;
+    if (equals == std::string::npos || name_end == 0) {
+      error = "predikat harus berbentuk kolom=nilai: " + term;
+      return false;
+    }
+
+    std::string name = term.substr(0, name_end);
+    std::string value = term.substr(equals + 1);
+    Field field;
+    if (!fieldFromName(name, field)) {
+      error = "kolom tidak dikenal: " + name;
+      return false;
+    }
+
+    Predicate probe{field, {}};
+    if (probe.isText()) {
+      std::vector<std::string> values;
+      std::stringstream stream(value);
+      for (std::string item; std::getline(stream, item, ',');) {
+        values.push_back(item);
+      }
+      if (values.empty()) values.push_back("");
+      whereAny(field, values, negated);
+      return true;
+    }
+
+    long long low = LLONG_MIN, high = LLONG_MAX;
+    size_t dots = value.find("..");
+    bool ok = dots == std::string::npos
+                  ? parseNumber(value, low) && parseNumber(value, high)
+                  : (dots == 0 || parseNumber(value.substr(0, dots), low)) &&
+                        (dots + 2 == value.size() ||
+                         parseNumber(value.substr(dots + 2), high));
+    if (!ok) {
+      error = "nilai " + name + " tidak valid: " + value;
+      return false;
+    }
+
+    whereRange(field, low, high, negated);
+    return true;
+  }
+
+  const std::vector<Predicate>& predicates() const { return predicates_; }
+  bool empty() const { return predicates_.empty(); }
+
+  static const char* fieldName(Field field) {
+    static const char* kNames[] = {"id",     "title",    "artist", "genre",
+                                   "year",   "decade",   "duration",
+                                   "plays"};
+    return kNames[static_cast<int>(field)];
+  }
+
+ private:
+  std::vector<Predicate> predicates_; /**< Predikat yang digabung dengan AND */
+
+  static bool fieldFromName(const std::string& name, Field& field) {
+    for (int i = 0; i <= static_cast<int>(Field::kPlays); i++) {
+      if (name == fieldName(static_cast<Field>(i))) {
+        field = static_cast<Field>(i);
+        return true;
+      }
+    }
+    return false;
+  }
+
+  static bool parseNumber(const std::string& text, long long& value) {
+    const char* end = text.data() + text.size();
+    auto result = std::from_chars(text.data(), end, value);
+    return !text.empty() && result.ec == std::errc() && result.ptr == end;
+  }
+};
+
+/**
+ * @class QueryEngine
+ * @brief Menjalankan SongQuery dengan memanfaatkan index SongLibrary
+ *
+ * Setiap predikat diberi perkiraan jumlah baris yang lolos: dihitung tepat
+ * dari index jika ada (bitmap genre / artis / dekade, OrderedIndex tahun dan
+ * durasi, urutan ID), atau memakai selektivitas default untuk kolom tanpa
+ * index (kesamaan 1/10, rentang 1/3). Predikat diurutkan dari yang paling
+ * selektif.
+ *
+ * Jika predikat ber-index paling selektif cukup kecil, hasilnya menjadi
+ * bitmap kandidat awal. Predikat bitmap lain digabung dengan AND / AND NOT
+ * per word, predikat rentang ber-index ikut dipotong jika hasilnya tidak
+ * jauh lebih besar dari kandidat, sisa predikat diperiksa pada setiap
+ * kandidat. Jika tidak, seluruh lagu ditelusuri sekali dengan seluruh
+ * predikat diperiksa sekaligus (fused scan). Query yang seluruh predikatnya
+ * memiliki bitmap dapat dihitung (count()) tanpa membaca satu lagu pun.
+ */
+class QueryEngine {
+ public:
+  /**
+   * @brief Cara sebuah predikat dijalankan
+   *
+   */
+  enum class Access {
+    kDrive,     /**< Menghasilkan kandidat awal dari index */
+    kIntersect, /**< Index dipotong dengan kandidat */
+    kFilter     /**< Diperiksa pada setiap lagu */
+  };
+
+  /**
+   * @brief Sumber perkiraan jumlah baris sebuah predikat
+   *
+   */
+  enum class Source {
+    kDefault, /**< Selektivitas default, tanpa index */
+    kIndex,   /**< OrderedIndex / urutan ID */
+    kBitmap   /**< RoaringBitmap */
+  };
+
+  /**
+   * @brief Satu langkah rencana eksekusi
+   *
+   */
+  struct Step {
+    SongQuery::Predicate predicate;
+    size_t estimate; /**< Perkiraan jumlah lagu yang lolos */
+    Source source;
+    Access access;
+
+    bool indexed() const { return source != Source::kDefault; }
+  };
+
+  /**
+   * @brief Rencana eksekusi query
+   *
+   */
+  struct Plan {
+    std::vector<Step> steps; /**< Urut dari predikat paling selektif */
+    size_t rows{0};          /**< Jumlah lagu dalam database */
+    bool scan{true};         /**< Memakai fused scan */
+  };
+
+  explicit QueryEngine(SongLibrary& library) : library_(library) {}
+
+  /**
+   * @brief Menyusun rencana eksekusi berdasarkan perkiraan selektivitas
+   *
+   */
+  Plan plan(const SongQuery& query) {
+    Plan plan;
+    plan.rows = library_.size();
+    for (const SongQuery::Predicate& predicate : query.predicates()) {
+      Step step{predicate, 0, Source::kDefault, Access::kFilter};
+      step.source = estimate(predicate, plan.rows, step.estimate);
+      plan.steps.push_back(step);
+    }
+    std::stable_sort(plan.steps.begin(), plan.steps.end(),
+                     [](const Step& a, const Step& b) {
+                       return a.estimate < b.estimate;
+                     });
+
+    auto driver = std::find_if(plan.steps.begin(), plan.steps.end(),
+                               [](const Step& step) { return step.indexed(); });
+    if (driver == plan.steps.end() ||
+        driver->estimate > plan.rows / kScanFraction) {
+      return plan;
+    }
+
+    plan.scan = false;
+    driver->access = Access::kDrive;
+    size_t candidates = driver->estimate;
+    for (Step& step : plan.steps) {
+      if (!step.indexed() || step.access == Access::kDrive) continue;
+      // Bitmap cukup dipotong per container, rentang harus dikumpulkan dulu
+      if (step.source == Source::kIndex &&
+          step.estimate > candidates * kIntersectRatio) {
+        continue;
+      }
+
+      step.access = Access::kIntersect;
+      candidates = std::min(candidates, step.estimate);
+    }
+    return plan;
+  }
+
+  /**
+   * @brief Menjalankan query
+   *
+   * @param visit Dipanggil dengan const Song& untuk setiap lagu yang lolos,
+   * terurut berdasarkan ID. Berhenti jika mengembalikan false.
+   * @return size_t Jumlah lagu yang lolos
+   */
+  template <typename Visitor>
+  size_t run(const SongQuery& query, Visitor visit) {
+    RAIVFY_TIMED(kSearch);
+    Plan plan = this->plan(query);
+    std::vector<const SongQuery::Predicate*> filters;
+    for (const Step& step : plan.steps) {
+      if (step.access == Access::kFilter) filters.push_back(&step.predicate);
+    }
+
+    size_t matched = 0;
+    auto accept = [&](const Song& song) {
+      for (const SongQuery::Predicate* filter : filters) {
+        if (!filter->matches(song)) return true;
+      }
+      matched++;
+      return visit(song);
+    };
+
+    if (plan.scan) {
+      library_.forEachSong(accept);
+      return matched;
+    }
+
+    RoaringBitmap candidates = this->candidates(plan);
+    Song song;
+    candidates.forEach([&](uint64_t id) {
+      return !library_.findSong(static_cast<size_t>(id), song) || accept(song);
+    });
+    return matched;
+  }
+
+  /**
+   * @brief Menghitung lagu yang memenuhi query
+   *
+   * Jika seluruh predikat memiliki bitmap (genre, artis, dekade), jumlahnya
+   * dihitung langsung dari operasi bitmap tanpa membaca lagu.
+   */
+  size_t count(const SongQuery& query) {
+    RAIVFY_TIMED(kSearch);
+    Plan plan = this->plan(query);
+    bool bitmap_only = !plan.steps.empty() &&
+                       std::all_of(plan.steps.begin(), plan.steps.end(),
+                                   [](const Step& step) {
+                                     return step.source == Source::kBitmap;
+                                   });
+    if (!bitmap_only) {
+      return run(query, [](const Song&) { return true; });
+    }
+
+    if (plan.steps.size() == 1) return plan.steps[0].estimate;
+
+    RoaringBitmap result = bitmap(plan.steps[0].predicate);
+    for (size_t i = 1; i + 1 < plan.steps.size(); i++) {
+      combine(result, plan.steps[i].predicate);
+    }
+
+    const SongQuery::Predicate& last = plan.steps.back().predicate;
+    if (last.negated) {
+      combine(result, last);
+      return result.cardinality();
+    }
+    return RoaringBitmap::andCardinality(result, positiveBitmap(last));
+  }
+
+  /**
+   * @brief Menulis rencana eksekusi (satu langkah per baris, TSV)
+   *
+   */
+  static void explain(const Plan& plan, std::ostream& out) {
+    static const char* kAccess[] = {"drive", "intersect", "filter"};
+    static const char* kSource[] = {"default", "index", "bitmap"};
+    out << "plan\t" << (plan.scan ? "scan" : "index") << '\t' << plan.rows
+        << '\n';
+    for (const Step& step : plan.steps) {
+      out << "step\t" << (step.predicate.negated ? "!" : "")
+          << SongQuery::fieldName(step.predicate.field) << '\t'
+          << kAccess[static_cast<int>(step.access)] << '\t' << step.estimate
+          << '\t' << kSource[static_cast<int>(step.source)] << '\n';
+    }
+  }
+
+ private:
+  static constexpr size_t kScanFraction =
+      4; /**< Index dipakai jika kandidat <= 1/4 database */
+  static constexpr size_t kIntersectRatio =
+      8; /**< Rentang dipotong jika <= 8x jumlah kandidat */
+
+  SongLibrary& library_; /**< Database yang di-query */
+
+  /**
+   * @brief Mengecek apakah predikat dijawab dengan bitmap
+   *
+   * Jika SongStore melewati batas index, hanya dekade tanpa negasi yang
+   * memiliki bitmap (diambil dari tree tahun rilis).
+   */
+  bool hasBitmap(const SongQuery::Predicate& predicate) {
+    using Field = SongQuery::Field;
+    if (!library_.hasMemoryIndexes()) {
+      return predicate.field == Field::kDecade && !predicate.negated;
+    }
+    return predicate.field == Field::kGenre ||
+           predicate.field == Field::kArtist ||
+           predicate.field == Field::kDecade;
+  }
+
+  /**
+   * @brief Memperkirakan jumlah lagu yang lolos predikat
+   *
+   */
+  Source estimate(const SongQuery::Predicate& predicate, size_t rows,
+                  size_t& result) {
+    using Field = SongQuery::Field;
+    if (hasBitmap(predicate)) {
+      result = positiveBitmap(predicate).cardinality();
+      if (predicate.negated) result = rows - std::min(rows, result);
+      return Source::kBitmap;
+    }
+
+    switch (predicate.field) {
+      case Field::kYear:
+      case Field::kDuration:
+      case Field::kId:
+        if (predicate.field == Field::kDuration &&
+            !library_.hasMemoryIndexes()) {
+          // Tanpa index durasi, diperiksa per lagu seperti kolom lain
+          result = std::max<size_t>(1, rows / 3);
+          if (predicate.negated) result = rows - result;
+          return Source::kDefault;
+        }
+
+        if (predicate.field == Field::kId && library_.usesStore()) {
+          result = idSpan(predicate, rows);
+        } else {
+          result = library_.countRange(rangeColumn(predicate.field),
+                                       predicate.low, predicate.high);
+        }
+        if (!predicate.negated) return Source::kIndex;
+
+        // Rentang yang dinegasikan hanya diperiksa per lagu
+        result = rows - std::min(rows, result);
+        return Source::kDefault;
+      case Field::kTitle:
+        result = std::max<size_t>(1, rows / 10);
+        if (predicate.negated) result = rows - result;
+        return Source::kDefault;
+      default:
+        result = std::max<size_t>(1, rows / 3);
+        if (predicate.negated) result = rows - result;
+        return Source::kDefault;
+    }
+  }
+
+  /**
+   * @brief Perkiraan jumlah ID dalam rentang tanpa menelusuri store
+   *
+   */
+  static size_t idSpan(const SongQuery::Predicate& predicate, size_t rows) {
+    long long last = static_cast<long long>(Song::id_counter.load()) - 1;
+    long long low = std::max(1LL, predicate.low);
+    long long high = std::min(last, predicate.high);
+    if (low > high) return 0;
+    return std::min(rows, static_cast<size_t>(high - low + 1));
+  }
+
+  static SongLibrary::RangeColumn rangeColumn(SongQuery::Field field) {
+    if (field == SongQuery::Field::kYear) {
+      return SongLibrary::RangeColumn::kYear;
+    }
+    if (field == SongQuery::Field::kDuration) {
+      return SongLibrary::RangeColumn::kDuration;
+    }
+    return SongLibrary::RangeColumn::kId;
+  }
+
+  /**
+   * @brief Bitmap predikat tanpa memperhitungkan negasi (OR seluruh nilai)
+   *
+   */
+  RoaringBitmap positiveBitmap(const SongQuery::Predicate& predicate) {
+    if (predicate.field == SongQuery::Field::kDecade) {
+      return library_.decades(predicate.low, predicate.high);
+    }
+
+    auto column = predicate.field == SongQuery::Field::kGenre
+                      ? SongLibrary::TextColumn::kGenre
+                      : SongLibrary::TextColumn::kArtist;
+    if (predicate.values.size() == 1) {
+      return library_.bitmap(column, predicate.values[0]);
+    }
+
+    RoaringBitmap result;
+    for (const std::string& value : predicate.values) {
+      result |= library_.bitmap(column, value);
+    }
+    return result;
+  }
+
+  /**
+   * @brief Bitmap ID lagu yang lolos predikat ber-index
+   *
+   */
+  RoaringBitmap bitmap(const SongQuery::Predicate& predicate) {
+    if (hasBitmap(predicate)) {
+      if (!predicate.negated) return positiveBitmap(predicate);
+
+      RoaringBitmap result = library_.allSongs();
+      result -= positiveBitmap(predicate);
+      return result;
+    }
+
+    std::vector<size_t> ids;
+    library_.collectIds(rangeColumn(predicate.field), predicate.low,
+                        predicate.high, ids);
+    std::sort(ids.begin(), ids.end());
+
+    RoaringBitmap result;
+    for (size_t id : ids) result.add(id);
+    return result;
+  }
+
+  /**
+   * @brief Memotong kandidat dengan predikat ber-index (AND / AND NOT)
+   *
+   */
+  void combine(RoaringBitmap& candidates,
+               const SongQuery::Predicate& predicate) {
+    if (hasBitmap(predicate) && predicate.negated) {
+      candidates -= positiveBitmap(predicate);
+    } else {
+      candidates &= bitmap(predicate);
+    }
+  }
+
+  RoaringBitmap candidates(const Plan& plan) {
+    RoaringBitmap result;
+    for (const Step& step : plan.steps) {
+      if (step.access == Access::kDrive) result = bitmap(step.predicate);
+    }
+    for (const Step& step : plan.steps) {
+      if (step.access != Access::kIntersect || result.empty()) continue;
+      combine(result, step.predicate);
+    }
+    return result;
+  }
+};
+
+/**
+ * @class SongImporter
+ * @brief Impor massal lagu dari file CSV / TSV ke SongLibrary
+ *
+ * Kolom: judul, artis, genre, tahun, durasi, dan (opsional) jumlah diputar.
+ * Baris yang kolom angkanya tidak valid (misalnya header) dilewati. Lagu
+ * ditambahkan tanpa pengecekan per lagu, index dibangun ulang sekali di
+ * akhir. Penyimpanan ke file dilakukan oleh pemanggil, juga sekali.
+ */
+class SongImporter {
+ public:
+  /**
+   * @brief Ringkasan hasil impor
+   *
+   */
+  struct Result {
+    size_t imported{0}; /**< Jumlah lagu yang ditambahkan */
+    size_t skipped{0};  /**< Jumlah baris yang dilewati */
+  };
+
+  explicit SongImporter(SongLibrary& library) : library_(library) {}
+
+  /**
+   * @brief Menentukan pemisah kolom dari ekstensi file
+   *
+   * @return char ',' untuk .csv, '\t' untuk lainnya
+   */
+  static char delimiterFor(const std::string& filename) {
+    bool csv = filename.size() >= 4 &&
+               filename.compare(filename.size() - 4, 4, ".csv") == 0;
+    return csv ? ',' : '\t';
+  }
+
+  /**
+   * @brief Mengimpor seluruh lagu dari file
+   *
+   * @param filename Nama file sumber
+   * @param result Tempat menyimpan ringkasan hasil impor
+   * @return false jika file tidak dapat dibuka
+   */
+  bool importFile(const std::string& filename, Result& result) {
+    FILE* file = fopen(filename.c_str(), "rb");
+    if (!file) return false;
+
+    DelimitedReader reader(file, delimiterFor(filename));
+    Song song;
+    while (reader.next()) {
+      if (!toSong(reader, song)) {
+        if (reader.fieldCount() > 1 || !reader.field(0).empty()) {
+          result.skipped++;
+        }
+        continue;
+      }
+
+      song.id = Song::id_counter++;
+      if (!library_.appendUnindexed(song)) {
+        result.skipped++;
+        continue;
+      }
+      result.imported++;
+    }
+
+    fclose(file);
+    library_.reindex();
+    return true;
+  }
+
+ private:
+  SongLibrary& library_; /**< Library tujuan impor */
+
+  /**
+   * @brief Mengisi Song dari record, tanpa alokasi
+   *
+   * @return false jika jumlah kolom kurang / terlalu banyak atau kolom angka
+   * tidak valid
+   */
+  static bool toSong(const DelimitedReader& reader, Song& song) {
+    if (reader.fieldCount() < 5 || reader.truncated()) return false;
+
+    size_t play_count = 0;
+    if (!parseNumber(reader.field(3), song.release_year) ||
+        !parseNumber(reader.field(4), song.duration) ||
+        (reader.fieldCount() > 5 &&
+         !parseNumber(reader.field(5), play_count))) {
+      return false;
+    }
+
+    song.play_count = play_count;
+    copyField(song.title, reader.field(0));
+    copyField(song.artist, reader.field(1));
+    copyField(song.genre, reader.field(2));
+    return true;
+  }
+
+  template <typename Number>
+  static bool parseNumber(std::string_view text, Number& value) {
+    while (!text.empty() && text.front() == ' ') text.remove_prefix(1);
+    while (!text.empty() && text.back() == ' ') text.remove_suffix(1);
+
+    const char* end = text.data() + text.size();
+    auto parsed = std::from_chars(text.data(), end, value);
+    return parsed.ec == std::errc() && parsed.ptr == end;
+  }
+
+  template <size_t Size>
+  static void copyField(char (&target)[Size], std::string_view text) {
+    size_t length = std::min(text.size(), Size - 1);
+    std::memcpy(target, text.data(), length);
+    target[length] = '\0';
+  }
+};
+
+/**
+ * @struct PlaylistSnapshot
+ * @brief Salinan isi playlist yang tidak pernah diubah setelah diterbitkan
+ *
+ */
+struct PlaylistSnapshot {
+  std::vector<Song> songs; /**< Lagu-lagu playlist sesuai urutan */
+  size_t version{0};       /**< Nomor versi snapshot */
+};
+
+/**
+ * @class PlaylistFeed
+ * @brief Saluran penerbitan snapshot playlist dengan pola RCU
+ *
+ * Thread UI menerbitkan snapshot baru setiap kali playlist berubah, sedangkan
+ * thread pemutar hanya membaca snapshot terbaru. Snapshot lama tetap hidup
+ * selama masih dipegang pembaca, sehingga kedua thread tidak pernah saling
+ * menunggu dan tidak ada data yang dibaca sambil diubah.
+ */
+class PlaylistFeed {
+ public:
+  using Listener = std::function<void()>;
+
+  /**
+   * @brief Mengambil snapshot terbaru
+   *
+   * @return std::shared_ptr<const PlaylistSnapshot> Snapshot terbaru
+   */
+  std::shared_ptr<const PlaylistSnapshot> load() const {
+    return std::atomic_load(&current_);
+  }
+
+  /**
+   * @brief Menerbitkan snapshot baru menggantikan snapshot sebelumnya
+   *
+   * Seluruh listener dipanggil setelah snapshot terbit, di luar mutex feed.
+   *
+   * @param snapshot Snapshot baru
+   */
+  void publish(std::shared_ptr<const PlaylistSnapshot> snapshot) {
+    std::atomic_store(&current_, std::move(snapshot));
+
+    std::vector<Listener> listeners;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      for (const auto& entry : listeners_) listeners.push_back(entry.second);
+    }
+    for (const Listener& listener : listeners) listener();
+  }
+
+  /**
+   * @brief Mendaftarkan fungsi yang dipanggil setiap snapshot baru terbit
+   *
+   * @return size_t Token untuk unsubscribe()
+   */
+  size_t subscribe(Listener listener) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    listeners_.emplace_back(++listener_counter_, std::move(listener));
+    return listener_counter_;
+  }
+
+  void unsubscribe(size_t token) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto matches = [token](const auto& entry) { return entry.first == token; };
+    listeners_.erase(
+        std::remove_if(listeners_.begin(), listeners_.end(), matches),
+        listeners_.end());
+  }
+
+ private:
+  std::shared_ptr<const PlaylistSnapshot> current_; /**< Snapshot terbaru */
+  std::mutex mutex_;                                /**< Pelindung listener */
+  std::vector<std::pair<size_t, Listener>>
+      listeners_;              /**< Listener beserta tokennya */
+  size_t listener_counter_{0}; /**< Auto-increment token listener */
+};
+
+/**
+ * @class Playlist
+ * @brief Kelas yang merepresentasikan sebuah daftar putar (playlist) berisi
+ * lagu-lagu.
+ *
+ * Kelas ini memungkinkan pengguna untuk menambahkan, menghapus, memutar,
+ * menjeda, dan menampilkan lagu-lagu dalam playlist. Lagu-lagu disimpan dalam
+ * struktur data IndexedList sehingga akses dan pemindahan berdasarkan posisi
+ * berjalan dalam O(log n).
+ */
+class Playlist {
+ public:
+  static size_t
+      id_counter; /**< Variable untuk auto-increment ID setiap playlist */
+
+  /**
+   * @brief Constructor default, menginisialisasi playlist dengan ID unik
+   * berdasarkan id_counter
+   *
+   */
+  Playlist() : id_(id_counter) {}
+
+  /**
+   * @brief Constructor dengan nama playlist
+   *
+   * @param name Nama dari playlist
+   */
+  Playlist(std::string name) : id_(id_counter++), loaded_(true) {
+    std::strcpy(name_, name.c_str());
+  }
+
+  /**
+   * @brief Constructor salinan playlist
+   *
+   * Node lagu disalin ke pool milik playlist baru, sehingga tabel handle
+   * dibangun ulang agar menunjuk ke node milik salinan.
+   *
+   * @param other Playlist sumber
+   */
+  Playlist(const Playlist& other) { *this = other; }
+
+  Playlist& operator=(const Playlist& other) {
+    if (this == &other) return *this;
+
+    std::memcpy(name_, other.name_, sizeof(name_));
+    id_ = other.id_;
+    list_ = other.list_;
+    rebuildHandles();
+    feed_.reset();
+    loaded_ = other.loaded_;
+    dirty_ = other.dirty_;
+    stored_count_ = other.stored_count_;
+    persistence_ = other.persistence_;
+    return *this;
+  }
+
+  /**
+   * @brief Constructor pemindahan playlist
+   *
+   * Node lagu, tabel handle, dan saluran snapshot ikut dipindahkan, sehingga
+   * pembaca yang memegang saluran tetap menerima perubahan. Dipakai saat
+   * ArrayList memperbesar kapasitas atau menggeser elemen.
+   *
+   * @param other Playlist sumber, menjadi kosong setelah dipindahkan
+   */
+  Playlist(Playlist&& other) noexcept { *this = std::move(other); }
+
+  Playlist& operator=(Playlist&& other) noexcept {
+    if (this == &other) return *this;
+
+    std::memcpy(name_, other.name_, sizeof(name_));
+    id_ = other.id_;
+    list_ = std::move(other.list_);
+    handles_ = std::move(other.handles_);
+    other.handles_.clear();
+    feed_ = std::move(other.feed_);
+    version_ = other.version_;
+    loaded_ = other.loaded_;
+    dirty_ = other.dirty_;
+    stored_count_ = other.stored_count_;
+    persistence_ = other.persistence_;
+    return *this;
+  }
+
+  /**
+   * @brief Mengambil data ID dari playlist
+   *
+   * @return const size_t ID unik playlist
+   */
+  size_t id() const { return id_; }
+
+  /**
+   * @brief Mengambil nama playlist
+   *
+   * @return const std::string& Nama playlist
+   */
+  std::string name() { return std::string(name_); }
+
+  /**
+   * @brief Mengambil nama file tempat lagu-lagu playlist disimpan
+   *
+   * @return std::string Nama file playlist (termasuk ekstensi)
+   */
+  std::string filename() { return name() + ".dat"; }
+
+  /**
+   * @brief Mengambil jumlah lagu dalam playlist
+   *
+   * Jika daftar lagu belum dimuat, jumlah diambil dari hasil perhitungan
+   * ukuran file sehingga tidak perlu memuat playlist ke memori.
+   *
+   * @return size_t Jumlah lagu dalam playlist
+   */
+  size_t count() { return loaded_ ? list_.count() : stored_count_; }
+
+  /**
+   * @brief Mengecek apakah daftar lagu sudah berada di memori
+   *
+   * @return true jika daftar lagu sudah dimuat
+   */
+  bool isLoaded() const { return loaded_; }
+
+  /**
+   * @brief Mengambil daftar lagu dalam playlist
+   *
+   * Pastikan ensureLoaded() sudah dipanggil sebelum mengakses isi list.
+   *
+   * @return IndexedList<Song>& Referensi ke IndexedList berisi lagu-lagu
+   */
+  IndexedList<Song>& list() { return list_; }
+
+  /**
+   * @brief Mengisi jumlah lagu playlist tanpa memuat isinya
+   *
+   * Dipanggil saat startup berdasarkan ukuran file playlist.
+   */
+  void scanCount() {
+    stored_count_ = FileManager::countRecords(filename(), Song::kRecordSize);
+  }
+
+  /**
+   * @brief Memuat daftar lagu dari file jika belum berada di memori
+   *
+   * @return true jika playlist baru saja dimuat dari file
+   * @return false jika playlist sudah berada di memori sebelumnya
+   */
+  bool ensureLoaded() {
+    if (loaded_) return false;
+
+    list_.clear();
+    FileManager::load(filename(), list_);
+    rebuildHandles();
+    loaded_ = true;
+    publish();
+    return true;
+  }
+
+  /**
+   * @brief Mengeluarkan daftar lagu dari memori
+   *
+   * Perubahan yang belum disimpan akan ditulis ke file terlebih dahulu,
+   * sehingga playlist dapat dimuat ulang dengan ensureLoaded(). Snapshot yang
+   * masih menunggu di thread penyimpanan diambil alih dan ditulis langsung,
+   * agar file tidak tertinggal dari isi playlist saat dimuat ulang. Jika
+   * penulisan gagal, playlist tetap berada di memori.
+   */
+  void evict() {
+    if (!loaded_) return;
+    if (persistence_ && persistence_->cancel(filename())) dirty_ = true;
+    if (dirty_ && !FileManager::save(filename(), list_)) return;
+    dirty_ = false;
+
+    stored_count_ = list_.count();
+    list_.releaseMemory();
+    handles_.clear();
+    loaded_ = false;
+  }
+
+  /**
+   * @brief Perkiraan memori yang dipakai daftar lagu playlist
+   *
+   * @return size_t Jumlah byte blok node lagu yang berada di memori
+   */
+  size_t residentBytes() { return loaded_ ? list_.memoryUsage() : 0; }
+
+  /**
+   * @brief Menambahkan lagu ke dalam playlist
+   *
+   * @param song Lagu yang ingin ditambahkan
+   */
+  void addSong(const Song& song) {
+    handles_.emplace(song.id, list_.push(song));
+    markDirty();
+  }
+
+  /**
+   * @brief Mengecek apakah lagu sudah ada di dalam playlist dalam O(1)
+   *
+   * @param song_id ID lagu yang dicek
+   * @return true jika lagu sudah ada di playlist
+   */
+  bool contains(size_t song_id) const {
+    return handles_.find(song_id) != handles_.end();
+  }
+
+  /**
+   * @brief Menghapus lagu dari playlist
+   *
+   * @param song Lagu yang akan dihapus
+   */
+  void removeSong(const Song& song) { removeSongById(song.id); }
+
+  /**
+   * @brief Menghapus lagu dari playlist berdasarkan ID
+   *
+   * Node lagu diambil langsung dari tabel handle, sehingga tidak perlu
+   * menelusuri playlist dari awal. Jika lagu yang sama muncul lebih dari
+   * sekali, yang dihapus adalah kemunculan pertama.
+   *
+   * @param song_id ID lagu yang akan dihapus
+   * @return true jika lagu ditemukan dan dihapus
+   */
+  bool removeSongById(size_t song_id) {
+    auto range = handles_.equal_range(song_id);
+    if (range.first == range.second) return false;
+
+    IndexedList<Song>::NodeType* first = range.first->second;
+    for (auto handle = std::next(range.first); handle != range.second;
+         handle++) {
+      if (list_.indexOf(handle->second) < list_.indexOf(first)) {
+        first = handle->second;
+      }
+    }
+
+    eraseNode(first);
+    return true;
+  }
+
+  /**
+   * @brief Memindahkan lagu ke posisi lain dalam playlist
+   *
+   * @param from Posisi lagu yang dipindahkan (mulai dari 0)
+   * @param to Posisi tujuan lagu (mulai dari 0)
+   * @return true jika posisi valid dan lagu berhasil dipindahkan
+   */
+  bool moveSong(size_t from, size_t to) {
+    if (from >= list_.count() || to >= list_.count()) return false;
+
+    list_.moveRange(from, from + 1, to);
+    markDirty();
+    return true;
+  }
+
+  /**
+   * @brief Membalik urutan lagu dalam playlist
+   *
+   */
+  void reverse() {
+    list_.reverse();
+    markDirty();
+  }
+
+  /**
+   * @brief Mengambil saluran snapshot playlist untuk dibaca thread lain
+   *
+   * Selama saluran masih dipegang pembaca, setiap perubahan playlist akan
+   * menerbitkan snapshot baru.
+   *
+   * @return std::shared_ptr<PlaylistFeed> Saluran snapshot playlist
+   */
+  std::shared_ptr<PlaylistFeed> feed() {
+    if (!feed_) {
+      feed_ = std::make_shared<PlaylistFeed>();
+      feed_->publish(snapshot());
+    }
+    return feed_;
+  }
+
+  /**
+   * @brief Mengecek apakah playlist memiliki perubahan yang belum disimpan
+   *
+   * @return true jika isi playlist di memori berbeda dengan isi file
+   */
+  bool isDirty() const { return dirty_; }
+
+  /**
+   * @brief Menghubungkan playlist dengan thread penyimpanan
+   *
+   * Setelah terhubung, persist() mengirim snapshot ke thread penyimpanan
+   * alih-alih menulis file secara langsung.
+   *
+   * @param persistence Thread penyimpanan tujuan snapshot playlist
+   */
+  void attach(PersistenceWorker& persistence) { persistence_ = &persistence; }
+
+  /**
+   * @brief Menyimpan isi playlist ke file jika ada perubahan
+   *
+   * Isi playlist di memori adalah sumber data utama, file hanya diperbarui
+   * saat method ini dipanggil (misalnya setelah setiap perintah atau saat
+   * keluar). Perubahan beruntun di antaranya hanya menghasilkan satu
+   * snapshot. Snapshot yang gagal ditulis thread penyimpanan dikirim ulang.
+   *
+   * @return true jika tidak ada perubahan atau penyimpanan berhasil
+   */
+  bool persist() {
+    if (persistence_ && persistence_->takeFailure(filename())) dirty_ = true;
+    if (!dirty_) return true;
+    if (persistence_) {
+      persistence_->schedule(filename(), list_);
+    } else if (!FileManager::save(filename(), list_)) {
+      return false;
+    }
+
+    dirty_ = false;
+    return true;
+  }
+
+  /**
+   * @brief Operasi penyimpanan atribut playlist ke dalam file
+   *
+   * @return true jika playlist berhasil disimpan
+   */
+  bool serialize(Writer& out) const { return out.write(name_, 255); }
+
+  /**
+   * @brief Operasi pembacaan atribut playlist dari file
+   *
+   * @return true jika seluruh pembacaan berjalan dengan baik
+   * @return false jika terjadi kegagalan dalam pembacaan file
+   */
+  bool deserialize(Reader& in) {
+    if (!in.read(&name_[0], 255)) return false;
+    name_[254] = '\0';
+    loaded_ = false;
+
+    Playlist::id_counter++;
+    return true;
+  }
+
+  /**
+   * @brief Menampilkan daftar lagu dalam bentuk tabel yang terformat
+   *
+   */
+  void displayList() {
+    RAIVFY_TIMED(kRender);
+    Frame frame(list_.count() + 6);
+    frame.endLine().endLine().rule(61).endLine();
+    frame.boldCell("ID", 5)
+        .boldCell("Judul", 18)
+        .boldCell("Artis", 18)
+        .boldCell("Tahun", 8)
+        .boldCell("Durasi", 8)
+        .boldCell("Diputar", 15)
+        .endLine();
+    frame.rule(61).endLine();
+
+    for (auto* x = list_.head(); x != nullptr; x = x->next) {
+      frame.cell(x->data.id, 5)
+          .cell(x->data.title, 18)
+          .cell(x->data.artist, 18)
+          .cell(static_cast<long long>(x->data.release_year), 8)
+          .cell(x->data.duration, 8)
+          .cell(x->data.play_count, 15)
+          .endLine();
+    }
+    frame.endLine().endLine();
+    Screen::stream(frame);
+  }
+
+ private:
+  char name_[255]{};                   /**< Nama playlist */
+  size_t id_;                          /**< ID unik dari playlist */
+  IndexedList<Song> list_; /**< Daftar lagu dalam bentuk IndexedList */
+  std::unordered_multimap<size_t, IndexedList<Song>::NodeType*>
+      handles_; /**< Tabel ID lagu ke node lagu dalam list */
+  bool loaded_{false};     /**< Status daftar lagu sudah dimuat ke memori */
+  bool dirty_{false};      /**< Status perubahan yang belum disimpan */
+  size_t stored_count_{0}; /**< Jumlah lagu di file saat belum dimuat */
+  PersistenceWorker* persistence_{nullptr}; /**< Thread penyimpanan */
+
+  std::shared_ptr<PlaylistFeed> feed_; /**< Saluran snapshot untuk pembaca */
+  size_t version_{0}; /**< Nomor versi snapshot terakhir */
+
+  /**
+   * @brief Menandai playlist berubah dan menerbitkan snapshot baru
+   *
+   * Isi playlist tidak diserialisasi di sini, melainkan sekali saat
+   * persist() dipanggil.
+   */
+  void markDirty() {
+    dirty_ = true;
+    publish();
+  }
+
+  /**
+   * @brief Membuat snapshot dari isi playlist saat ini
+   *
+   */
+  std::shared_ptr<const PlaylistSnapshot> snapshot() {
+    auto snapshot = std::make_shared<PlaylistSnapshot>();
+    snapshot->songs.reserve(list_.count());
+    snapshot->version = ++version_;
+
+    for (auto* node = list_.head(); node; node = node->next) {
+      snapshot->songs.push_back(node->data);
+    }
+    return snapshot;
+  }
+
+  /**
+   * @brief Menerbitkan snapshot baru jika ada pembaca yang memegang saluran
+   *
+   */
+  void publish() {
+    if (feed_ && feed_.use_count() > 1) feed_->publish(snapshot());
+  }
+
+  /**
+   * @brief Menghapus node beserta entri tabel handle milik node tersebut
+   *
+   * Entri dicari berdasarkan alamat node, bukan hanya ID lagu, agar lagu
+   * duplikat di posisi lain tetap memiliki handle yang benar.
+   */
+  void eraseNode(IndexedList<Song>::NodeType* node) {
+    auto range = handles_.equal_range(node->data.id);
+    for (auto handle = range.first; handle != range.second; handle++) {
+      if (handle->second == node) {
+        handles_.erase(handle);
+        break;
+      }
+    }
+
+    list_.erase(node);
+    markDirty();
+  }
+
+  /**
+   * @brief Membangun ulang tabel handle dari isi list
+   *
+   */
+  void rebuildHandles() {
+    handles_.clear();
+    handles_.reserve(list_.count());
+
+    for (auto* node = list_.head(); node; node = node->next) {
+      handles_.emplace(node->data.id, node);
+    }
+  }
+};
+
+/**
+ * @class ShuffleOrder
+ * @brief Urutan acak (permutasi indeks) untuk pemutaran acak playlist
+ *
+ * Menyimpan permutasi indeks lagu, bukan salinan lagu, sehingga playlist
+ * tidak pernah diubah maupun disalin. Permutasi dibangun secara lazy dengan
+ * Fisher-Yates: slot ke-i baru diputuskan saat pertama kali dibutuhkan,
+ * sehingga setiap slot O(1). Membangun ulang urutan (reset) tetap O(n)
+ * karena permutasi identitas diisi ulang, sedangkan putaran baru O(1).
+ *
+ * Satu putaran (cycle) memutar setiap lagu tepat satu kali. Putaran baru
+ * diacak ulang tanpa memulai dengan lagu terakhir putaran sebelumnya. Lagu
+ * yang ditambahkan ke playlist masuk ke bagian yang belum diputuskan, jadi
+ * tetap terpilih secara acak pada putaran yang sedang berjalan.
+ */
+class ShuffleOrder {
+ public:
+  static constexpr size_t kNone = static_cast<size_t>(-1); /**< Tanpa lagu */
+
+  /**
+   * @brief Membangun ulang urutan untuk playlist berisi count lagu
+   *
+   * @param count Jumlah lagu
+   * @param first Lagu yang ditempatkan pada slot pertama (kNone jika acak)
+   */
+  void reset(size_t count, size_t first) {
+    order_.resize(count);
+    for (size_t i = 0; i < count; i++) order_[i] = i;
+
+    decided_ = 0;
+    last_ = kNone;
+    cycle_++;
+    if (first < count) {
+      std::swap(order_[0], order_[first]);
+      decided_ = 1;
+    }
+  }
+
+  /**
+   * @brief Menambahkan lagu baru (indeks size() hingga count - 1)
+   *
+   * O(1) amortized per lagu, lagu baru ikut diacak pada putaran berjalan.
+   *
+   * @param count Jumlah lagu setelah penambahan
+   */
+  void append(size_t count) {
+    for (size_t i = order_.size(); i < count; i++) order_.push_back(i);
+  }
+
+  /**
+   * @brief Memulai putaran baru setelah seluruh lagu diputar
+   *
+   */
+  void startCycle() {
+    last_ = order_.empty() ? kNone : order_.back();
+    decided_ = 0;
+    cycle_++;
+  }
+
+  /**
+   * @brief Mengambil indeks lagu pada slot tertentu di putaran ini
+   *
+   * @param slot Slot urutan (0 hingga size() - 1)
+   * @param songs Isi playlist, untuk membandingkan penyanyi
+   * @param smart true agar lagu dari penyanyi yang sama tidak berurutan
+   * @return size_t Indeks lagu dalam playlist
+   */
+  size_t at(size_t slot, const std::vector<Song>& songs, bool smart) {
+    while (decided_ <= slot) decide(songs, smart);
+    return order_[slot];
+  }
+
+  size_t size() const { return order_.size(); }
+  size_t cycle() const { return cycle_; }
+
+ private:
+  static constexpr size_t kRetries =
+      8; /**< Batas percobaan mencari lagu dari penyanyi lain */
+
+  std::vector<size_t> order_; /**< Permutasi indeks lagu */
+  size_t decided_{0};         /**< Jumlah slot yang sudah diputuskan */
+  size_t last_{kNone};        /**< Lagu terakhir putaran sebelumnya */
+  size_t cycle_{0};           /**< Nomor putaran */
+  std::mt19937 rng_{std::random_device{}()}; /**< Sumber angka acak */
+
+  /**
+   * @brief Memutuskan satu slot berikutnya (satu langkah Fisher-Yates)
+   *
+   * Kandidat diambil acak dari slot yang belum diputuskan. Kandidat ditolak
+   * jika sama dengan lagu sebelumnya, atau (mode smart) dari penyanyi yang
+   * sama, hingga kRetries kali.
+   */
+  void decide(const std::vector<Song>& songs, bool smart) {
+    size_t i = decided_++;
+    size_t previous = i > 0 ? order_[i - 1] : last_;
+    std::uniform_int_distribution<size_t> pick(i, order_.size() - 1);
+
+    size_t j = pick(rng_);
+    for (size_t attempt = 0; attempt < kRetries && previous != kNone &&
+                             order_.size() - i > 1;
+         attempt++) {
+      size_t candidate = order_[j];
+      bool repeated = candidate == previous;
+      bool same_artist = smart && candidate < songs.size() &&
+                         previous < songs.size() &&
+                         std::strcmp(songs[candidate].artist,
+                                     songs[previous].artist) == 0;
+      if (!repeated && !same_artist) break;
+      j = pick(rng_);
+    }
+
+    std::swap(order_[i], order_[j]);
+  }
+};
+
+/**
+ * @class PlaybackEngine
+ * @brief Penjadwal pemutaran playlist berbasis event dengan satu thread
+ *
+ * Setiap sesi pemutaran hanya mendaftarkan deadline berikutnya (akhir lagu
+ * atau refresh tampilan) ke dalam antrian prioritas. Thread penjadwal tidur
+ * dengan condition variable hingga deadline terdekat atau hingga ada perintah
+ * baru, sehingga saat tidak ada yang diputar (atau sedang dijeda dan tidak
+ * ditampilkan) thread tidak bangun sama sekali. Banyak sesi dapat berjalan
+ * bersamaan di atas thread yang sama.
+ *
+ * Sesi tidak pernah membaca Playlist secara langsung, melainkan snapshot dari
+ * PlaylistFeed, sehingga UI bebas mengubah playlist kapan saja.
+ *
+ * Beberapa lagu berikutnya disiapkan lebih dulu (prefetch) di luar mutex:
+ * metadata diambil dari snapshot database dan buffer judul berjalan dibuat,
+ * sehingga pergantian lagu cukup mengambil lagu yang sudah siap. Urutan lagu
+ * yang disiapkan mengikuti mode ulang (repeat) dan mode acak (shuffle) sesi.
+ * Mutex engine hanya dipegang sebentar untuk mengubah status sesi, penulisan
+ * ke terminal dilakukan di luar mutex agar UI tidak pernah menunggu thread
+ * pemutar.
+ */
+class PlaybackEngine {
+ public:
+  using SessionId = size_t;
+  using Clock = std::chrono::steady_clock;
+
+  static constexpr SessionId kNoSession = 0; /**< ID sesi tidak valid */
+
+  /**
+   * @brief Event yang dikirim setiap kali sebuah lagu selesai diputar
+   *
+   */
+  struct PlayEvent {
+    size_t song_id; /**< ID lagu yang selesai diputar */
+  };
+
+  /**
+   * @brief Mode pengulangan pemutaran
+   *
+   */
+  enum class RepeatMode {
+    kAll, /**< Kembali ke awal playlist setelah lagu terakhir */
+    kOne, /**< Mengulang lagu yang sama */
+    kOff  /**< Berhenti setelah lagu terakhir */
+  };
+
+  /**
+   * @brief Mode pemutaran acak
+   *
+   */
+  enum class ShuffleMode {
+    kOff,  /**< Berurutan sesuai playlist */
+    kOn,   /**< Acak, setiap lagu sekali per putaran */
+    kSmart /**< Acak, menghindari penyanyi yang sama berturut-turut */
+  };
+
+  PlaybackEngine() = default;
+  PlaybackEngine(const PlaybackEngine&) = delete;
+  PlaybackEngine& operator=(const PlaybackEngine&) = delete;
+
+  ~PlaybackEngine() { shutdown(); }
+
+  /**
+   * @brief Memulai sesi pemutaran baru dari awal playlist
+   *
+   * @param feed Saluran snapshot playlist yang akan diputar
+   * @param display Menampilkan status pemutaran di terminal atau tidak
+   * @return SessionId ID sesi untuk perintah pause / resume / skip / stop
+   */
+  SessionId start(std::shared_ptr<PlaylistFeed> feed, bool display = false) {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    if (!worker_.joinable()) {
+      running_ = true;
+      worker_ = std::thread(&PlaybackEngine::run, this);
+    }
+
+    SessionId id = ++session_counter_;
+    Session& session = sessions_[id];
+    session.feed = std::move(feed);
+    session.display = display;
+    session.listener =
+        session.feed->subscribe([this, id] { playlistChanged(id); });
+    beginTrack(session, Advance::kRestart, Clock::now());
+    schedule(id, session);
+    requestPrefetch(id, session);
+    return id;
+  }
+
+  /**
+   * @brief Menjeda sesi pemutaran, sisa waktu lagu disimpan
+   *
+   * @param id ID sesi
+   */
+  void pause(SessionId id) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    Session* session = find(id);
+    if (!session || session->paused) return;
+
+    session->remaining = std::max(Clock::duration::zero(),
+                                  session->track_end - Clock::now());
+    session->paused = true;
+    session->generation++;
+  }
+
+  /**
+   * @brief Melanjutkan sesi pemutaran yang sedang dijeda
+   *
+   * @param id ID sesi
+   */
+  void resume(SessionId id) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    Session* session = find(id);
+    if (session && session->idle && !session->paused) {
+      // Playlist sudah selesai diputar, ulangi dari awal
+      restart(*session);
+      schedule(id, *session);
+      requestPrefetch(id, *session);
+      return;
+    }
+    if (!session || !session->paused) return;
+
+    session->paused = false;
+    session->track_end = Clock::now() + session->remaining;
+    schedule(id, *session);
+    requestPrefetch(id, *session);
+  }
+
+  /**
+   * @brief Melewati lagu yang sedang diputar dan langsung memutar lagu
+   * berikutnya
+   *
+   * @param id ID sesi
+   */
+  void skip(SessionId id) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    Session* session = find(id);
+    if (!session) return;
+
+    beginTrack(*session, Advance::kSkip, Clock::now());
+    if (!session->paused) schedule(id, *session);
+    requestPrefetch(id, *session);
+  }
+
+  /**
+   * @brief Mengatur mode pengulangan sesi
+   *
+   * Lagu yang sudah disiapkan dibuang karena urutannya bisa berubah. Sesi
+   * yang berhenti di akhir playlist langsung dilanjutkan jika mode baru
+   * memiliki lagu berikutnya.
+   *
+   * @param id ID sesi
+   * @param mode Mode pengulangan baru
+   */
+  void setRepeat(SessionId id, RepeatMode mode) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    Session* session = find(id);
+    if (!session || session->repeat == mode) return;
+
+    session->repeat = mode;
+    discardUpcoming(*session);
+    wakeIdle(id, *session);
+    requestPrefetch(id, *session);
+  }
+
+  /**
+   * @brief Mengatur mode acak sesi
+   *
+   * Mengaktifkan mode acak membangun urutan baru yang dimulai dari lagu yang
+   * sedang diputar.
+   *
+   * @param id ID sesi
+   * @param mode Mode acak baru
+   */
+  void setShuffle(SessionId id, ShuffleMode mode) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    Session* session = find(id);
+    if (!session || session->shuffle == mode) return;
+
+    if (session->shuffle == ShuffleMode::kOff && session->snapshot) {
+      session->order.reset(session->snapshot->songs.size(), session->position);
+      session->slot = 0;
+      session->cycle = session->order.cycle();
+    }
+    session->shuffle = mode;
+    discardUpcoming(*session);
+    requestPrefetch(id, *session);
+  }
+
+  /**
+   * @brief Mengambil mode acak sesi
+   *
+   * @param id ID sesi
+   * @return ShuffleMode Mode acak (kOff jika sesi tidak ada)
+   */
+  ShuffleMode shuffleMode(SessionId id) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    Session* session = find(id);
+    return session ? session->shuffle : ShuffleMode::kOff;
+  }
+
+  /**
+   * @brief Mengambil mode pengulangan sesi
+   *
+   * @param id ID sesi
+   * @return RepeatMode Mode pengulangan (kAll jika sesi tidak ada)
+   */
+  RepeatMode repeatMode(SessionId id) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    Session* session = find(id);
+    return session ? session->repeat : RepeatMode::kAll;
+  }
+
+  /**
+   * @brief Mengganti snapshot yang dipakai untuk metadata lagu
+   *
+   * @param catalog Snapshot metadata lagu terbaru dari database
+   */
+  void setCatalog(std::shared_ptr<const CatalogSnapshot> catalog) {
+    std::atomic_store(&catalog_, std::move(catalog));
+  }
+
+  /**
+   * @brief Mengambil jumlah pergantian lagu yang memakai lagu hasil prefetch
+   *
+   * @return size_t Jumlah pergantian tanpa persiapan ulang
+   */
+  size_t prefetchHits() const {
+    return prefetch_hits_.load(std::memory_order_relaxed);
+  }
+
+  /**
+   * @brief Mengambil jumlah pergantian lagu yang harus disiapkan di tempat
+   *
+   * @return size_t Jumlah pergantian yang tidak memakai hasil prefetch
+   */
+  size_t prefetchMisses() const {
+    return prefetch_misses_.load(std::memory_order_relaxed);
+  }
+
+  /**
+   * @brief Menghentikan dan menghapus sesi pemutaran
+   *
+   * @param id ID sesi
+   */
+  void stop(SessionId id) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    Session* session = find(id);
+    if (!session) return;
+
+    session->feed->unsubscribe(session->listener);
+    sessions_.erase(id);
+  }
+
+  /**
+   * @brief Mengatur apakah status pemutaran sesi ditampilkan di terminal
+   *
+   * @param id ID sesi
+   * @param display true untuk menampilkan status pemutaran
+   */
+  void setDisplay(SessionId id, bool display) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    Session* session = find(id);
+    if (!session || session->display == display) return;
+
+    session->display = display;
+    if (!session->paused) schedule(id, *session);
+  }
+
+  /**
+   * @brief Mengecek apakah sesi masih aktif
+   *
+   * @param id ID sesi
+   * @return true jika sesi belum dihentikan
+   */
+  bool isActive(SessionId id) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return find(id) != nullptr;
+  }
+
+  /**
+   * @brief Mengecek apakah sesi sedang dijeda
    *
-   * @param data ArrayList data lagu.
-   * @param awal Indeks awal.
-   * @param akhir Indeks akhir.
-   * @param comparator Fungsi pembanding untuk menentukan urutan.
+   * @param id ID sesi
+   * @return true jika sesi aktif dan sedang dijeda
    */
-  static void quickSort(
-      ArrayList<Song>& data, size_t awal, size_t akhir,
-      std::function<bool(const Song&, const Song&)> comparator) {
-    if (awal < akhir) {
-      size_t pivot = partition(data, awal, akhir, comparator);
-      if (pivot > awal) quickSort(data, awal, pivot - 1, comparator);
-      if (pivot < akhir) quickSort(data, pivot + 1, akhir, comparator);
-    }
+  bool isPaused(SessionId id) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    Session* session = find(id);
+    return session && session->paused;
   }
 
   /**
-   * @brief Membalikkan urutan comparator menjadi descending.
+   * @brief Mengambil satu event lagu selesai diputar tanpa menunggu
    *
-   * @tparam T Tipe data (misalnya: Song).
-   * @param comparator Fungsi pembanding ascending.
-   * @return Comparator yang hasilnya dibalik.
+   * Hanya boleh dipanggil dari satu thread (consumer).
+   *
+   * @param event Tempat menyimpan event
+   * @return true jika ada event yang diambil
    */
-  template <typename T>
-  static std::function<bool(const T&, const T&)> reverseOrder(
-      std::function<bool(const T&, const T&)> comparator) {
-    return [comparator](const T& a, const T& b) { return comparator(b, a); };
+  bool pollPlayEvent(PlayEvent& event) { return play_events_.pop(event); }
+
+  /**
+   * @brief Mengambil jumlah event yang terbuang karena antrian penuh
+   *
+   * @return size_t Jumlah event yang terbuang
+   */
+  size_t droppedPlayEvents() const {
+    return dropped_events_.load(std::memory_order_relaxed);
+  }
+
+  /**
+   * @brief Menghentikan seluruh sesi dan menunggu thread penjadwal selesai
+   *
+   */
+  void shutdown() {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      running_ = false;
+      for (auto& entry : sessions_) {
+        entry.second.feed->unsubscribe(entry.second.listener);
+      }
+      sessions_.clear();
+    }
+
+    wake_.notify_all();
+    if (worker_.joinable()) worker_.join();
   }
 
  private:
-  static constexpr size_t kQuickSortThreshold = 30;
+  static constexpr std::chrono::milliseconds kRedrawInterval{
+      200}; /**< Jeda refresh tampilan judul berjalan */
+  static constexpr int kTrackTimeScale =
+      10; /**< Pembagi durasi lagu untuk simulasi pemutaran */
+  static constexpr size_t kTitleWidth = 8; /**< Lebar judul berjalan */
+  static constexpr size_t kPrefetchDepth =
+      3; /**< Jumlah lagu berikutnya yang disiapkan lebih dulu */
+
   /**
-   * @brief Fungsi partisi pada algoritma quickSort.
+   * @brief Cara berpindah ke lagu berikutnya
    *
-   * @param data ArrayList lagu.
-   * @param index_awal Indeks awal.
-   * @param index_akhir Indeks akhir.
-   * @param comparator Comparator untuk sorting.
-   * @return Indeks pivot setelah partisi.
    */
-  static size_t partition(
-      ArrayList<Song>& data, size_t index_awal, size_t index_akhir,
-      std::function<bool(const Song&, const Song&)> comparator) {
-    Song pivot = data.arr[index_akhir];
-    size_t i = index_awal;
+  enum class Advance {
+    kRestart, /**< Memutar lagu pada posisi saat ini dari awal */
+    kNext,    /**< Lagu selesai, lanjut sesuai mode ulang */
+    kSkip     /**< Dilewati pengguna, selalu pindah ke lagu lain */
+  };
 
-    for (size_t j = index_awal; j < index_akhir; ++j) {
-      if (comparator(data.arr[j], pivot)) {
-        swap(&data.arr[j], &data.arr[i]);
-        i++;
+  /**
+   * @brief Posisi sebuah lagu pada playlist dan urutan acak sesi
+   *
+   */
+  struct Cursor {
+    size_t position; /**< Urutan lagu dalam snapshot */
+    size_t slot;     /**< Slot pada urutan acak */
+    size_t cycle;    /**< Putaran urutan acak */
+  };
+
+  /**
+   * @brief Lagu yang sudah siap diputar
+   *
+   */
+  struct PreparedTrack {
+    size_t position{0};       /**< Urutan lagu dalam snapshot */
+    size_t slot{0};           /**< Slot pada urutan acak */
+    size_t cycle{0};          /**< Putaran urutan acak */
+    size_t song_id{0};        /**< ID lagu */
+    std::string title;        /**< Judul + spasi, buffer judul berjalan */
+    Clock::duration length{}; /**< Lama pemutaran */
+  };
+
+  /**
+   * @brief Status satu sesi pemutaran
+   *
+   */
+  struct Session {
+    std::shared_ptr<PlaylistFeed> feed; /**< Saluran snapshot playlist */
+    size_t listener{0};                 /**< Token listener pada feed */
+    std::shared_ptr<const PlaylistSnapshot>
+        snapshot;                /**< Snapshot yang sedang diputar */
+    size_t position{0};          /**< Urutan lagu yang sedang diputar */
+    size_t song_id{0};           /**< ID lagu yang sedang diputar */
+    std::string title;           /**< Judul lagu + spasi untuk animasi */
+    RepeatMode repeat{RepeatMode::kAll};    /**< Mode pengulangan */
+    ShuffleMode shuffle{ShuffleMode::kOff}; /**< Mode acak */
+    ShuffleOrder order;          /**< Urutan acak atas snapshot */
+    size_t slot{0};              /**< Slot lagu saat ini pada urutan acak */
+    size_t cycle{0};             /**< Putaran urutan acak lagu saat ini */
+    std::deque<PreparedTrack> upcoming; /**< Lagu berikutnya yang sudah siap */
+    size_t upcoming_epoch{0};    /**< Versi antrian, naik saat dibuang */
+    bool prefetching{false};     /**< Prefetch sudah dijadwalkan */
+    size_t scroll{0};            /**< Posisi awal judul berjalan */
+    Clock::time_point track_end; /**< Waktu lagu selesai */
+    Clock::duration remaining{}; /**< Sisa waktu lagu saat dijeda */
+    bool paused{false};          /**< Status jeda */
+    bool display{false};         /**< Status tampilan di terminal */
+    bool idle{false};     /**< Playlist kosong atau selesai diputar */
+    size_t generation{0}; /**< Versi jadwal, event lama diabaikan */
+  };
+
+  /**
+   * @brief Satu deadline dalam antrian penjadwal
+   *
+   */
+  struct Event {
+    Clock::time_point when; /**< Waktu event dijalankan */
+    SessionId id;           /**< Sesi pemilik event */
+    size_t generation;      /**< Versi jadwal saat event dibuat */
+    bool prefetch;          /**< Event untuk menyiapkan lagu berikutnya */
+
+    bool operator>(const Event& rhs) const { return when > rhs.when; }
+  };
+
+  std::mutex mutex_;                      /**< Pelindung status engine */
+  std::condition_variable wake_;          /**< Pembangun thread penjadwal */
+  std::thread worker_;                    /**< Thread penjadwal tunggal */
+  bool running_{false};                   /**< Status thread penjadwal */
+  SessionId session_counter_{kNoSession}; /**< Auto-increment ID sesi */
+  std::map<SessionId, Session> sessions_; /**< Seluruh sesi aktif */
+  std::priority_queue<Event, std::vector<Event>, std::greater<Event>>
+      events_; /**< Antrian deadline, terdekat di atas */
+  SpscRing<PlayEvent, 4096>
+      play_events_; /**< Antrian lagu selesai diputar, dibaca thread UI */
+  std::atomic<size_t> dropped_events_{0}; /**< Event terbuang (antrian penuh) */
+  std::shared_ptr<const CatalogSnapshot>
+      catalog_; /**< Snapshot metadata lagu untuk prefetch */
+  std::atomic<size_t> prefetch_hits_{0}; /**< Pergantian lagu dari prefetch */
+  std::atomic<size_t> prefetch_misses_{
+      0}; /**< Pergantian lagu tanpa prefetch */
+
+  Session* find(SessionId id) {
+    auto session = sessions_.find(id);
+    return session == sessions_.end() ? nullptr : &session->second;
+  }
+
+  /**
+   * @brief Menyamakan sesi dengan snapshot playlist terbaru
+   *
+   * Jika playlist berubah, posisi lagu yang sedang diputar dicari ulang pada
+   * snapshot baru dan lagu yang sudah disiapkan dibuang. Urutan acak cukup
+   * diperpanjang jika playlist hanya bertambah di akhir, selain itu dibangun
+   * ulang mulai dari lagu yang sedang diputar.
+   *
+   * @return true jika lagu yang sedang diputar masih ada di playlist
+   */
+  bool syncSnapshot(Session& session) {
+    std::shared_ptr<const PlaylistSnapshot> latest = session.feed->load();
+    if (latest == session.snapshot) return true;
+
+    const std::vector<Song>& songs = latest->songs;
+    bool found = true;
+    bool appended = false;
+    if (session.snapshot) {
+      const std::vector<Song>& old_songs = session.snapshot->songs;
+      appended = old_songs.size() <= songs.size() &&
+                 std::equal(old_songs.begin(), old_songs.end(), songs.begin(),
+                            [](const Song& a, const Song& b) {
+                              return a.id == b.id;
+                            });
+
+      auto current = std::find_if(
+          songs.begin(), songs.end(),
+          [&session](const Song& song) { return song.id == session.song_id; });
+
+      found = current != songs.end();
+      if (found) {
+        session.position = static_cast<size_t>(current - songs.begin());
       }
     }
 
-    swap(&data.arr[i], &data.arr[index_akhir]);
+    if (session.shuffle != ShuffleMode::kOff) {
+      if (appended) {
+        session.order.append(songs.size());
+      } else {
+        session.order.reset(songs.size(),
+                            found ? session.position : ShuffleOrder::kNone);
+        session.slot = found ? 0 : ShuffleOrder::kNone;
+        session.cycle = session.order.cycle();
+      }
+    }
 
-    return (i);
+    session.snapshot = latest;
+    discardUpcoming(session);
+    return found;
   }
 
   /**
-   * @brief Menukar posisi dua elemen dalam array lagu.
+   * @brief Menentukan lagu setelah lagu tertentu
    *
-   * @param data1 Pointer ke elemen pertama.
-   * @param data2 Pointer ke elemen kedua.
+   * Mengikuti mode acak dan mode ulang sesi. Pada mode acak, lagu setelah
+   * slot terakhir adalah awal putaran baru yang diacak ulang.
+   *
+   * @param manual true jika perpindahan diminta pengguna (skip), sehingga
+   * mode ulang satu lagu tetap berpindah ke lagu lain
+   * @param lookahead true jika dipanggil untuk prefetch. Putaran acak baru
+   * tidak dimulai lebih awal, karena antrian prefetch bisa dibuang sebelum
+   * sisa putaran berjalan selesai diputar.
+   * @param next Tempat menyimpan lagu berikutnya
+   * @return false jika tidak ada lagu berikutnya
    */
-  static void swap(Song* data1, Song* data2) {
-    Song temporary = *data1;
-    *data1 = *data2;
-    *data2 = temporary;
+  static bool nextTrack(Session& session, const Cursor& from, bool manual,
+                        bool lookahead, Cursor& next) {
+    const std::vector<Song>& songs = session.snapshot->songs;
+    size_t count = songs.size();
+    if (count == 0) return false;
+
+    if (session.repeat == RepeatMode::kOne && !manual &&
+        from.position < count) {
+      next = from;
+      return true;
+    }
+
+    if (session.shuffle == ShuffleMode::kOff) {
+      size_t position = from.position + 1;
+      if (position >= count) {
+        if (session.repeat == RepeatMode::kOff) return false;
+        position = 0;
+      }
+      next = {position, 0, 0};
+      return true;
+    }
+
+    ShuffleOrder& order = session.order;
+    bool smart = session.shuffle == ShuffleMode::kSmart;
+    size_t slot = from.slot == ShuffleOrder::kNone ? 0 : from.slot + 1;
+    if (from.cycle != order.cycle()) {
+      // Putaran asal sudah lewat, lanjut dari awal putaran yang berjalan
+      slot = 0;
+    } else if (slot >= order.size()) {
+      if (session.repeat == RepeatMode::kOff || lookahead) return false;
+      order.startCycle();
+      slot = 0;
+    }
+
+    next = {order.at(slot, songs, smart), slot, order.cycle()};
+    return true;
+  }
+
+  /**
+   * @brief Menyiapkan satu lagu agar siap diputar
+   *
+   * Judul dan durasi diambil dari snapshot metadata jika lagu ada di
+   * dalamnya, sehingga perubahan data lagu ikut terlihat meski playlist
+   * menyimpan salinan lama.
+   */
+  static PreparedTrack prepare(const PlaylistSnapshot& snapshot,
+                               const CatalogSnapshot* catalog,
+                               const Cursor& cursor) {
+    const Song& song = snapshot.songs[cursor.position];
+    PreparedTrack track;
+    track.position = cursor.position;
+    track.slot = cursor.slot;
+    track.cycle = cursor.cycle;
+    track.song_id = song.id;
+    track.title = song.title;
+    size_t duration = song.duration;
+
+    const TrackInfo* info = catalog ? catalog->find(song.id) : nullptr;
+    if (info) {
+      track.title = info->title;
+      duration = info->duration;
+    }
+
+    track.title.append(kTitleWidth, ' ');
+    track.length = std::chrono::seconds(duration / kTrackTimeScale);
+    return track;
+  }
+
+  void discardUpcoming(Session& session) {
+    session.upcoming.clear();
+    session.upcoming_epoch++;
+  }
+
+  /**
+   * @brief Menyiapkan lagu berikutnya sebagai lagu yang diputar
+   *
+   * Lagu diambil dari antrian prefetch jika tersedia, jika tidak lagu
+   * disiapkan saat itu juga.
+   */
+  void beginTrack(Session& session, Advance advance, Clock::time_point now) {
+    bool still_there = syncSnapshot(session);
+    const std::vector<Song>& songs = session.snapshot->songs;
+    session.generation++;
+
+    Cursor current{session.position, session.slot, session.cycle};
+    Cursor target = current;
+    bool playable = !songs.empty();
+    bool manual = advance == Advance::kSkip;
+    if (playable && advance != Advance::kRestart && still_there &&
+        !session.upcoming.empty() &&
+        !(manual && session.repeat == RepeatMode::kOne)) {
+      // Antrian prefetch sudah berisi lagu berikutnya sesuai mode sesi
+      const PreparedTrack& front = session.upcoming.front();
+      target = {front.position, front.slot, front.cycle};
+    } else if (playable && advance != Advance::kRestart &&
+               (still_there || session.shuffle != ShuffleMode::kOff)) {
+      playable = nextTrack(session, current, manual, false, target);
+    } else if (playable && target.position >= songs.size()) {
+      // Lagu terakhir dihapus, lagu berikutnya adalah awal playlist
+      playable = session.repeat != RepeatMode::kOff ||
+                 advance == Advance::kRestart;
+      target.position = 0;
+    }
+
+    session.idle = !playable;
+    if (session.idle) return;
+
+    PreparedTrack track;
+    if (!session.upcoming.empty() &&
+        session.upcoming.front().position == target.position &&
+        session.upcoming.front().cycle == target.cycle) {
+      track = std::move(session.upcoming.front());
+      session.upcoming.pop_front();
+      prefetch_hits_.fetch_add(1, std::memory_order_relaxed);
+    } else {
+      discardUpcoming(session);
+      track = prepare(*session.snapshot, std::atomic_load(&catalog_).get(),
+                      target);
+      if (advance != Advance::kRestart) {
+        prefetch_misses_.fetch_add(1, std::memory_order_relaxed);
+      }
+    }
+
+    session.position = track.position;
+    session.slot = track.slot;
+    session.cycle = track.cycle;
+    session.song_id = track.song_id;
+    session.title = std::move(track.title);
+    session.scroll = 0;
+    session.track_end = now + track.length;
+    session.remaining = track.length;
+  }
+
+  /**
+   * @brief Dipanggil feed setiap kali playlist sesi menerbitkan snapshot
+   *
+   * Sesi yang aktif akan membaca snapshot baru saat pergantian lagu, jadi
+   * hanya sesi yang sedang diam (playlist kosong atau sudah selesai) yang
+   * perlu dibangunkan.
+   */
+  void playlistChanged(SessionId id) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    Session* session = find(id);
+    if (!session) return;
+
+    wakeIdle(id, *session);
+    requestPrefetch(id, *session);
+  }
+
+  /**
+   * @brief Melanjutkan sesi diam ke lagu setelah lagu terakhir yang diputar
+   *
+   */
+  void wakeIdle(SessionId id, Session& session) {
+    if (!session.idle || session.paused) return;
+
+    beginTrack(session, Advance::kNext, Clock::now());
+    schedule(id, session);
+  }
+
+  /**
+   * @brief Memutar ulang playlist dari lagu pertama (atau putaran acak baru)
+   *
+   */
+  void restart(Session& session) {
+    syncSnapshot(session);
+    const std::vector<Song>& songs = session.snapshot->songs;
+    if (songs.empty()) return;
+
+    session.position = 0;
+    if (session.shuffle != ShuffleMode::kOff) {
+      session.order.startCycle();
+      session.slot = 0;
+      session.cycle = session.order.cycle();
+      session.position = session.order.at(
+          0, songs, session.shuffle == ShuffleMode::kSmart);
+    }
+    discardUpcoming(session);
+    beginTrack(session, Advance::kRestart, Clock::now());
+  }
+
+  /**
+   * @brief Menjadwalkan prefetch jika antrian lagu berikutnya belum penuh
+   *
+   */
+  void requestPrefetch(SessionId id, Session& session) {
+    if (session.prefetching || session.idle ||
+        session.upcoming.size() >= kPrefetchDepth) {
+      return;
+    }
+
+    session.prefetching = true;
+    events_.push({Clock::now(), id, 0, true});
+    wake_.notify_one();
+  }
+
+  /**
+   * @brief Mengisi antrian lagu berikutnya hingga kPrefetchDepth lagu
+   *
+   * Posisi lagu ditentukan di dalam mutex, sedangkan persiapan lagu
+   * dilakukan setelah mutex dilepas. Hasil dibuang jika antrian sudah
+   * dibuang (playlist atau mode ulang berubah) selama persiapan.
+   */
+  void prefetch(std::unique_lock<std::mutex>& lock, SessionId id,
+                Session& session) {
+    session.prefetching = false;
+    if (session.idle) return;
+
+    std::vector<Cursor> cursors;
+    Cursor from{session.position, session.slot, session.cycle};
+    if (!session.upcoming.empty()) {
+      const PreparedTrack& last = session.upcoming.back();
+      from = {last.position, last.slot, last.cycle};
+    }
+    while (session.upcoming.size() + cursors.size() < kPrefetchDepth) {
+      Cursor next;
+      if (!nextTrack(session, from, false, true, next)) break;
+      cursors.push_back(next);
+      from = next;
+    }
+    if (cursors.empty()) return;
+
+    std::shared_ptr<const PlaylistSnapshot> snapshot = session.snapshot;
+    std::shared_ptr<const CatalogSnapshot> catalog =
+        std::atomic_load(&catalog_);
+    size_t epoch = session.upcoming_epoch;
+
+    lock.unlock();
+    std::vector<PreparedTrack> prepared;
+    prepared.reserve(cursors.size());
+    for (const Cursor& cursor : cursors) {
+      prepared.push_back(prepare(*snapshot, catalog.get(), cursor));
+    }
+    lock.lock();
+
+    Session* current = find(id);
+    if (!current || current->upcoming_epoch != epoch) return;
+
+    for (PreparedTrack& track : prepared) {
+      current->upcoming.push_back(std::move(track));
+    }
+  }
+
+  /**
+   * @brief Mendaftarkan deadline berikutnya untuk sesi
+   *
+   * Deadline adalah akhir lagu, atau refresh tampilan berikutnya jika status
+   * pemutaran sedang ditampilkan.
+   */
+  void schedule(SessionId id, Session& session) {
+    session.generation++;
+    if (session.idle || session.paused) return;
+
+    Clock::time_point when = session.track_end;
+    if (session.display) {
+      when = std::min(when, Clock::now() + kRedrawInterval);
+    }
+
+    events_.push({when, id, session.generation, false});
+    wake_.notify_one();
+  }
+
+  /**
+   * @brief Menyusun status lagu yang sedang diputar untuk baris atas
+   *
+   * @return std::string Teks status beserta escape code posisi kursor
+   */
+  std::string render(Session& session, Clock::time_point now) {
+    std::string scrolling_title =
+        session.title.substr(session.scroll, kTitleWidth);
+    if (scrolling_title.length() < kTitleWidth) {
+      scrolling_title +=
+          session.title.substr(0, kTitleWidth - scrolling_title.length());
+    }
+    session.scroll = (session.scroll + 1) % session.title.length();
+
+    auto remaining = std::chrono::duration_cast<std::chrono::seconds>(
+        session.track_end - now + std::chrono::milliseconds(999));
+
+    std::ostringstream line;
+    line << "\033[s\033[2;24H"
+         << "Now Playing: " << scrolling_title << " | Remaining: "
+         << std::setw(3) << remaining.count() << "s"
+         << "\033[u";
+    return line.str();
+  }
+
+  /**
+   * @brief Loop thread penjadwal
+   *
+   * Thread menunggu deadline terdekat, lalu mengganti lagu jika lagu sudah
+   * selesai dan menampilkan status jika diperlukan. Penulisan ke terminal
+   * dilakukan setelah mutex dilepas.
+   */
+  void run() {
+    std::unique_lock<std::mutex> lock(mutex_);
+
+    while (running_) {
+      if (events_.empty()) {
+        wake_.wait(lock, [this] { return !running_ || !events_.empty(); });
+        continue;
+      }
+
+      Event event = events_.top();
+      Clock::time_point now = Clock::now();
+      if (now < event.when) {
+        wake_.wait_until(lock, event.when);
+        continue;
+      }
+
+      events_.pop();
+      Session* session = find(event.id);
+      if (session && event.prefetch) {
+        prefetch(lock, event.id, *session);
+        continue;
+      }
+      if (!session || session->generation != event.generation) continue;
+
+      if (now >= session->track_end) {
+        if (!session->idle && !play_events_.push({session->song_id})) {
+          dropped_events_.fetch_add(1, std::memory_order_relaxed);
+        }
+        beginTrack(*session, Advance::kNext, now);
+        requestPrefetch(event.id, *session);
+      }
+
+      std::string status;
+      if (session->display && !session->idle) status = render(*session, now);
+      schedule(event.id, *session);
+
+      if (!status.empty()) {
+        lock.unlock();
+        Screen::write(status);
+        lock.lock();
+      }
+    }
   }
 };
-#pragma endregion
 
-#pragma region Search Algorithm Implementation
 /**
- * @class SongSearcher
- * @brief Implementasi algoritma searching (penarian) untuk objek Song.
+ * @class PlayCountAggregator
+ * @brief Mengumpulkan event pemutaran dan menerapkannya ke database lagu
  *
- * Kelas ini mendukung pencarian berdasarkan genre, artis, dan judul lagu
- * menggunakan algoritma Binary Search atau Linear Search
+ * Event dari thread pemutar dibaca dari antrian lock-free, dijumlahkan per
+ * lagu, lalu diterapkan sekaligus ke SongLibrary. Snapshot database dikirim
+ * ke thread penyimpanan secara berkala, bukan setiap kali lagu selesai
+ * diputar.
  */
-class SongSearcher {
+class PlayCountAggregator {
  public:
-  static int result_index; /**< Indeks hasil dari pencarian binarySearch */
+  /**
+   * @brief Constructor aggregator untuk database tertentu
+   *
+   * @param library Database lagu tujuan
+   */
+  explicit PlayCountAggregator(SongLibrary& library) : library_(library) {}
+
+  /**
+   * @brief Mengambil seluruh event yang tersedia dan menerapkannya
+   *
+   * @param engine Engine pemutar sumber event
+   * @return size_t Jumlah event yang diterapkan
+   */
+  size_t drain(PlaybackEngine& engine) {
+    std::unordered_map<size_t, size_t> counts;
+    PlaybackEngine::PlayEvent event;
+    size_t total = 0;
+
+    while (engine.pollPlayEvent(event)) {
+      counts[event.song_id]++;
+      total++;
+    }
+
+    if (total > 0) {
+      library_.applyPlayCounts(counts);
+      pending_ = true;
+    }
+    return total;
+  }
+
+  /**
+   * @brief Menyimpan database jika ada perubahan dan sudah melewati jeda
+   *
+   */
+  void persistIfDue() {
+    if (std::chrono::steady_clock::now() - last_persist_ >= kPersistInterval) {
+      persist();
+    }
+  }
+
+  /**
+   * @brief Menyimpan database jika ada jumlah pemutaran yang berubah
+   *
+   */
+  void persist() {
+    if (pending_) {
+      library_.markDirty();
+      pending_ = false;
+    }
+    last_persist_ = std::chrono::steady_clock::now();
+  }
+
+ private:
+  static constexpr std::chrono::seconds kPersistInterval{
+      60}; /**< Jeda penyimpanan jumlah pemutaran */
+
+  SongLibrary& library_; /**< Database lagu tujuan */
+  bool pending_{false};  /**< Ada perubahan yang belum disimpan */
+  std::chrono::steady_clock::time_point last_persist_{
+      std::chrono::steady_clock::now()}; /**< Waktu penyimpanan terakhir */
+};
+
+/// Inisialisasi static variabel
+std::atomic<size_t> Song::id_counter{1};
+size_t Playlist::id_counter = 1;
+int SongSearcher::result_index = -1;
+
+/**
+ * @class RAiVFY
+ * @brief Kelas utama yang mengatur seluruh fungsionalitas aplikasi RAiVFY.
+ *
+ * Kelas ini menangani antarmuka pengguna, pemutaran playlist, pengelolaan lagu,
+ * pencarian lagu, serta manajemen file untuk penyimpanan data.
+ */
+class RAiVFY {
+ public:
+  /**
+   * @brief Memulai aplikasi RAiVFY.
+   *
+   * Jika terdapat playlist, lagu akan langsung diputar di thread terpisah.
+   * Setelah itu, program menampilkan menu utama.
+   */
+  void ignite() {
+    Screen::CoutCapture capture;
+    size_t index = 0;
+    isLogin = isAdmin = isPlaying = false;
+
+    while (true) {
+      if (!isLogin) {
+        isLogin = login();
+        continue;
+      }
+
+      flushIfDue();
+      if (isAdmin) {
+        playback_.setDisplay(session_, false);
+        menuAdmin();
+        continue;
+      }
+
+      if (!playlist_library.empty() && !isPlaying && !stopped_by_user_) {
+        if (index >= playlist_library.size()) index = 0;
+        while (index < playlist_library.size() - 1 &&
+               playlist_library.arr[index].count() == 0) {
+          index++;
+        }
+
+        startPlayback(index);
+      }
+
+      playback_.setDisplay(session_, true);
+      refreshCatalog();
+
+      mainMenu();
+    }
+  }
 
   /**
-   * @brief Mencari lagu berdasarkan ID menggunakan algoritma Binary Search.
+   * @brief Memuat data dari file eksternal ke dalam memori.
    *
-   * Akan mengurutkan data terlebih dahulu jika belum terurut.
+   * Memuat daftar lagu dan indeks playlist dari file menggunakan FileManager.
+   * Isi setiap playlist tidak ikut dimuat, melainkan baru dimuat saat pertama
+   * kali dibuka (lihat openPlaylist()).
    *
-   * @param target_id ID lagu yang dicari.
-   * @param data ArrayList lagu.
-   * @return true jika ditemukan, false jika tidak.
+   * Jika environment RAIVFY_SONG_STORE berisi nama file, database lagu
+   * disimpan di B+-tree pada file tersebut (lihat SongStore) sehingga tidak
+   * perlu dimuat seluruhnya ke memori. Saat file store baru dibuat, isinya
+   * diambil dari DatabaseLagu.dat. Lagu yang sering dibaca disimpan di
+   * SongCache, batas memorinya diatur dengan RAIVFY_SONG_CACHE_KB. Batas
+   * memori index lagu di atas store diatur dengan RAIVFY_INDEX_BUDGET_KB.
    */
-  static bool binarySearch(size_t target_id, ArrayList<Song>& data) {
-    if (data.empty()) return false;
+  void load() {
+    const char* budget = std::getenv("RAIVFY_PLAYLIST_BUDGET_KB");
+    if (budget) playlist_budget_ = std::strtoull(budget, nullptr, 10) * 1024;
 
-    SongSorter::ensureSortedByID(data);
+    const char* cache = std::getenv("RAIVFY_SONG_CACHE_KB");
+    if (cache) {
+      library.cache().setBudget(std::strtoull(cache, nullptr, 10) * 1024);
+    }
 
-    int start{0}, mid{0}, end{static_cast<int>(data.size()) - 1};
-    while (start <= end) {
-      mid = (start + end) / 2;
+    const char* index = std::getenv("RAIVFY_INDEX_BUDGET_KB");
+    if (index) library.setIndexBudget(std::strtoull(index, nullptr, 10) * 1024);
 
-      if (target_id == data.arr[mid].id) {
-        result_index = mid;
-        return true;
-      }
+    library.attach(persistence_, FileManager::kDatabase);
 
-      if (target_id > data.arr[mid].id) {
-        start = mid + 1;
-      } else if (target_id < data.arr[mid].id) {
-        end = mid - 1;
+    TaskPool pool;
+    pool.submit([this] {
+      const char* store = std::getenv("RAIVFY_SONG_STORE");
+      if (store && *store && song_store_.open(store)) {
+        if (!song_store_.created() || migrateToStore()) {
+          library.attachStore(song_store_);
+          return;
+        }
+
+        // Store dihapus agar migrasi diulang saat aplikasi dibuka lagi
+        song_store_.remove();
       }
-    }
-    result_index = -1;
-    return false;
+
+      FileManager::load(FileManager::kDatabase, library.database());
+      library.reindex();
+    });
+    pool.submit([this, &pool] {
+      loadPlaylistIndex();
+      preloadPlaylists(pool);
+    });
+    pool.wait();
   }
 
   /**
-   * @brief Mencari lagu berdasarkan genre (case-insensitive & substring).
+   * @brief Menjalankan perintah dari file / stream tanpa menu interaktif
    *
-   * @param genre Genre yang dicari.
-   * @param data ArrayList lagu.
-   * @return ArrayList lagu yang cocok.
+   * Satu perintah per baris, baris kosong dan baris yang diawali '#'
+   * diabaikan. Argumen yang mengandung spasi ditulis di dalam tanda kutip.
+   * Hasil ditulis ke stdout dalam format TSV, error ke stderr.
+   *
+   * @param commands Sumber perintah
+   * @return int Exit code, 0 jika seluruh perintah berhasil
    */
-  static ArrayList<Song> searchByGenre(const std::string& genre,
-                                       ArrayList<Song>& data) {
-    char normalized_genre[255];
-    std::strncpy(normalized_genre, normalizeString(genre.c_str()).c_str(), 254);
+  int runBatch(std::istream& commands) {
+    int status = 0;
+    std::string line;
+    for (size_t number = 1; std::getline(commands, line); number++) {
+      std::vector<std::string> args = splitCommand(line);
+      if (args.empty() || args[0][0] == '#') continue;
+      if (!executeCommand(args, number)) status = 1;
+      if (!persistChanges()) status = 1;
+    }
 
-    return linearSearch(data, [normalized_genre](const Song& song) {
-      char song_genre[255];
-      std::strncpy(song_genre, normalizeString(song.genre).c_str(), 254);
-      return std::strcmp(song_genre, normalized_genre) != 0 ? false : true;
-    });
+    if (!finishBatch()) status = 1;
+    return status;
   }
 
   /**
-   * @brief Mencari lagu berdasarkan artis (case-insensitive & substring).
+   * @brief Menjalankan satu perintah dari argumen program
    *
-   * @param artist Nama artis.
-   * @param data ArrayList lagu.
-   * @return ArrayList lagu yang cocok.
+   * @param args Nama perintah beserta argumennya
+   * @return int Exit code, 0 jika perintah berhasil
    */
-  static ArrayList<Song> searchByArtist(const std::string& artist,
-                                        ArrayList<Song>& data) {
-    char normalized_artist[255];
-    std::strncpy(normalized_artist, normalizeString(artist.c_str()).c_str(), 254);
-
-    return linearSearch(data, [normalized_artist](const Song& song) {
-      char song_artist[255];
-      std::strncpy(song_artist, normalizeString(song.artist).c_str(), 254);
-      return std::strcmp(song_artist, normalized_artist) != 0 ? false : true;
-    });
+  int runCommand(const std::vector<std::string>& args) {
+    bool ok = executeCommand(args, 0);
+    ok = finishBatch() && ok;
+    return ok ? 0 : 1;
   }
 
   /**
-   * @brief Mencari lagu berdasarkan judul (case-insensitive & substring).
+   * @brief Menampilkan daftar perintah mode batch
    *
-   * @param title Judul lagu.
-   * @param data ArrayList lagu.
-   * @return ArrayList lagu yang cocok.
    */
-  static ArrayList<Song> searchByTitle(const std::string& title,
-                                       ArrayList<Song>& data) {
-    char normalized_title[255];
-    std::strncpy(normalized_title, normalizeString(title.c_str()).c_str(), 254);
-
-    return linearSearch(data, [normalized_title](const Song& song) {
-      char song_title[255];
-      std::strncpy(song_title, normalizeString(song.title).c_str(), 254);
-      return std::strcmp(song_title, normalized_title) != 0 ? false : true;
-    });
+  static void printUsage(std::ostream& out) {
+    out << "Penggunaan: raivfy [perintah [argumen...]]\n"
+           "           raivfy --batch <file perintah | ->\n\n"
+           "Perintah:\n"
+           "  list                              seluruh lagu\n"
+           "  get <id>                          satu lagu\n"
+           "  range <id|year|duration|plays> <min> <max>\n"
+           "                                    lagu dalam rentang nilai\n"
+           "  count <id|year|duration|plays> <min> <max>\n"
+           "                                    jumlah lagu dalam rentang\n"
+           "  count <kolom=nilai>...            jumlah lagu yang memenuhi"
+           " query\n"
+           "  search <title|artist|genre> <kata kunci>\n"
+           "  query <kolom=nilai>...            lagu yang memenuhi seluruh"
+           " predikat\n"
+           "  explain <kolom=nilai>...          rencana eksekusi query\n"
+           "      kolom: id title artist genre year decade duration plays;\n"
+           "      a,b = salah satu nilai, kolom!=nilai = negasi,"
+           " min..max = rentang\n"
+           "  sort <id|title|year|plays> [asc|desc]\n"
+           "  import <file.tsv|file.csv>        judul, artis, genre, tahun,"
+           " durasi[, diputar]\n"
+           "  export <file | ->                 database dalam format TSV\n"
+           "  playlists                         id, nama, jumlah lagu\n"
+           "  playlist-create <nama>\n"
+           "  playlist-add <nama> <id>...\n"
+           "  playlist-show <nama>\n"
+           "  cache                             isi, kapasitas, hit, miss"
+           " cache lagu\n"
+           "  metrics [file | -]                statistik kinerja (JSON)\n\n"
+           "Kolom lagu: id, judul, artis, genre, tahun, durasi, diputar\n"
+           "Predikat query: id, title, artist, genre (teks utuh), year,"
+           " duration,\n"
+           "plays (nilai, min..max, min.. atau ..max), misalnya\n"
+           "  raivfy query genre=pop year=2015..2020 duration=..240\n";
   }
 
  private:
+  static constexpr size_t kDefaultPlaylistBudget =
+      4 * 1024 * 1024; /**< Batas memori default isi playlist (byte) */
+  static constexpr size_t kNotPlaying =
+      static_cast<size_t>(-1); /**< Penanda tidak ada playlist yang diputar */
+
+  PersistenceWorker persistence_; /**< Thread penyimpanan file */
+  SongStore song_store_; /**< Database lagu di disk (RAIVFY_SONG_STORE) */
+  SongLibrary library; /**< Objek untuk mengatur seluruh operasi database */
+  ArrayList<Playlist>
+      playlist_library; /** Koleksi playlist yang dimiliki user */
+  bool isAdmin,
+      isLogin;    /**< Menentukan user login atau belum & admin atau bukan */
+  bool isPlaying; /**< Playback status */
+  bool stopped_by_user_{
+      false}; /**< Pemutaran dihentikan user, jangan diputar otomatis */
+  size_t playlist_budget_{
+      kDefaultPlaylistBudget}; /**< Batas memori isi playlist yang dimuat */
+  size_t playing_index_{kNotPlaying}; /**< Indeks playlist yang diputar */
+  PlaybackEngine playback_; /**< Penjadwal pemutaran playlist */
+  Screen screen_;           /**< Lapisan render terminal */
+  PlayCountAggregator play_counts_{
+      library}; /**< Penerap jumlah pemutaran ke database */
+  PlaybackEngine::SessionId session_{
+      PlaybackEngine::kNoSession}; /**< Sesi pemutaran yang sedang berjalan */
+  size_t access_clock_{0}; /**< Penghitung akses untuk menentukan LRU */
+  size_t catalog_version_{
+      static_cast<size_t>(-1)}; /**< Versi database snapshot pemutar */
+  size_t catalog_playlist_{0}; /**< ID playlist snapshot pemutar */
+  std::vector<size_t>
+      last_access_; /**< Waktu akses terakhir setiap playlist */
+
+  static constexpr int kMinPageRows = 5; /**< Tinggi minimum halaman tabel */
+  static constexpr const char* kMetricsFile{
+      "metrics.json"}; /**< File tujuan ekspor statistik kinerja */
+  static constexpr int kPageChrome =
+      12; /**< Baris layar di luar isi tabel (judul, header, navigasi) */
+
   /**
-   * @brief Implementasi pencarian linear (filter) berdasarkan comparator.
+   * @brief Memutar playlist tertentu, menggantikan sesi yang sedang berjalan
    *
-   * @param data ArrayList lagu.
-   * @param comparator Fungsi yang menentukan apakah lagu cocok.
-   * @return ArrayList lagu yang memenuhi kondisi comparator.
+   * @param index Indeks playlist yang akan diputar
    */
-  static ArrayList<Song> linearSearch(
-      ArrayList<Song>& data, std::function<bool(const Song&)> comparator) {
-    size_t index{0};
-    ArrayList<Song> filtered_library;
-    while (index < data.size()) {
-      if (comparator(data.arr[index])) {
-        filtered_library.add(data.arr[index]);
-      }
-      index++;
-    }
-    return filtered_library;
+  void startPlayback(size_t index) {
+    stopPlayback();
+
+    playing_index_ = index;
+    Playlist& playlist = openPlaylist(index);
+    refreshCatalog();
+    session_ = playback_.start(playlist.feed());
+    isPlaying = true;
+    stopped_by_user_ = false;
   }
 
   /**
-   * @brief Menormalisasi string menjadi huruf kecil semua.
+   * @brief Memperbarui snapshot metadata lagu milik playlist yang diputar
    *
-   * @param string String asli.
-   * @return String hasil normalisasi.
+   * Snapshot dibangun ulang hanya jika database atau playlist yang diputar
+   * berubah. Lagu yang baru ditambahkan ke playlist setelahnya tetap diputar
+   * dengan salinan datanya sendiri.
    */
-  static std::string normalizeString(const char* string) {
-    std::string normalized;
+  void refreshCatalog() {
+    if (playing_index_ == kNotPlaying) return;
 
-    for (int i = 0; string[i] != '\0'; ++i) {
-      normalized += (unsigned char)std::tolower(string[i]);
+    Playlist& playlist = playlist_library.arr[playing_index_];
+    if (catalog_version_ == library.catalogVersion() &&
+        catalog_playlist_ == playlist.id()) {
+      return;
     }
 
-    return normalized;
+    playback_.setCatalog(library.catalog(playlist.list()));
+    catalog_version_ = library.catalogVersion();
+    catalog_playlist_ = playlist.id();
   }
-};
-#pragma endregion
 
-#pragma region Main App
-/**
- * @class SongLibrary
- * @brief Kelas yang mengatur seluruh operasi terhadap Database Lagu
- *
- */
-class SongLibrary {
- public:
   /**
-   * @brief Mengambil data lagu yang ada di database
+   * @brief Menghentikan sesi pemutaran yang sedang berjalan
    *
-   * @return ArrayList<Song>& Vector berisi lagu dalam database
    */
-  ArrayList<Song>& database() { return database_; }
+  void stopPlayback() {
+    playback_.stop(session_);
+    session_ = PlaybackEngine::kNoSession;
+    playing_index_ = kNotPlaying;
+    isPlaying = false;
+  }
 
   /**
-   * @brief Menambahkan lagu ke dalam database
+   * @brief Menghentikan pemutaran dan menyimpan seluruh perubahan sebelum
+   * aplikasi ditutup
    *
-   * @param song Data yang akan ditambahkan
+   * @return true jika seluruh perubahan sudah tertulis ke disk
    */
-  void addToLibrary(Song song) {
-    if (!SongSearcher::binarySearch(song.id, database_)) {
-      database_.add(song);
-    }
-
-    SongSorter::ensureSortedByID(database_);
+  bool shutdown() {
+    playback_.shutdown();
+    std::cout.flush();
+    play_counts_.drain(playback_);
+    play_counts_.persist();
+    bool ok = persistChanges();
+    ok = persistence_.flush() && ok;
+    return song_store_.flush() && ok;
   }
 
   /**
-   * @brief Menghapus lagu dari database berdasarkan ID
+   * @brief Menyalin isi DatabaseLagu.dat ke SongStore yang baru dibuat
    *
-   * @param target_id ID lagu yang akan dihapus
+   * Lagu dibaca satu per satu sehingga file database tidak perlu dimuat
+   * seluruhnya ke memori.
+   *
+   * @return false jika ada lagu yang gagal ditulis ke SongStore
    */
-  void removeSongById(size_t target_id) {
-    if (SongSearcher::binarySearch(target_id, database_)) {
-      for (size_t i = 0; i < database_.size(); i++) {
-        if (database_.arr[i].id == target_id) {
-          for (size_t j = i; j < database_.size() - 1; j++) {
-            database_.arr[j] = database_.arr[j + 1];
-          }
-          database_.decreaseSize();
-          break;
-        }
-      }
-    }
+  bool migrateToStore() {
+    MappedReader reader(FileManager::kDatabase);
+    if (!reader.isOpen()) return song_store_.flush();
+
+    Song song;
+    bool ok = true;
+    while (ok && song.deserialize(reader)) ok = song_store_.put(song);
+    if (ok && song_store_.flush()) return true;
+
+    std::cerr << "Gagal memindahkan database ke SongStore!\n";
+    return false;
   }
 
   /**
-   * @brief Mengambil data dari database berdasarkan ID
+   * @brief Menyimpan playlist yang masih memiliki perubahan ke file
    *
-   * @param target_id ID lagu yang akan diambil
-   * @return Song& Referensi Lagu dari hasil pencarian
+   * Playlist yang terhubung dengan thread penyimpanan mengirim snapshot ke
+   * thread tersebut, playlist lain langsung ditulis di sini.
+   *
+   * @return false jika ada playlist yang gagal ditulis
    */
-  Song& getSongById(int target_id) {
-    if (SongSearcher::binarySearch(target_id, database_)) {
-      int result = SongSearcher::result_index;
-      SongSearcher::result_index = -1;
-      return database_.arr[result];
+  bool flushPlaylists() {
+    bool ok = true;
+    for (size_t i = 0; i < playlist_library.size(); i++) {
+      ok = playlist_library.arr[i].persist() && ok;
     }
+    return ok;
   }
 
- private:
-  ArrayList<Song>
-      database_; /**< Vector berisi seluruh lagu yang ada (database) */
-};
-
-/**
- * @class Playlist
- * @brief Kelas yang merepresentasikan sebuah daftar putar (playlist) berisi
- * lagu-lagu.
- *
- * Kelas ini memungkinkan pengguna untuk menambahkan, menghapus, memutar,
- * menjeda, dan menampilkan lagu-lagu dalam playlist. Lagu-lagu disimpan dalam
- * struktur data LinkedList.
- */
-class Playlist {
- public:
-  static size_t
-      id_counter; /**< Variable untuk auto-increment ID setiap playlist */
-
   /**
-   * @brief Constructor default, menginisialisasi playlist dengan ID unik
-   * berdasarkan id_counter
+   * @brief Menyimpan seluruh playlist dan database yang berubah
    *
+   * Dipanggil sekali setelah setiap perintah, sehingga perubahan beruntun
+   * dalam satu perintah (misalnya playlist-add dengan banyak ID) hanya
+   * menghasilkan satu snapshot per file. Indeks playlist yang gagal ditulis
+   * thread penyimpanan dijadwalkan ulang di sini.
+   *
+   * @return false jika ada penyimpanan yang langsung diketahui gagal
    */
-  Playlist() : id_(id_counter) {}
+  bool persistChanges() {
+    if (persistence_.takeFailure(FileManager::kPlaylist)) {
+      persistence_.schedule(FileManager::kPlaylist, playlist_library);
+    }
+    bool ok = flushPlaylists();
+    return library.persist() && ok;
+  }
 
   /**
-   * @brief Constructor dengan nama playlist
+   * @brief Menerapkan jumlah pemutaran dan menyimpan perubahan yang ada
    *
-   * @param name Nama dari playlist
    */
-  Playlist(std::string name) : id_(id_counter++) {
-    std::strcpy(name_, name.c_str());
+  void flushIfDue() {
+    play_counts_.drain(playback_);
+    play_counts_.persistIfDue();
+    persistChanges();
   }
 
   /**
-   * @brief Mengambil data ID dari playlist
+   * @brief Membaca argumen angka, seluruh teks harus berupa angka
    *
-   * @return const size_t ID unik playlist
+   * @return false jika teks kosong, bukan angka, atau di luar jangkauan
    */
-  size_t id() const { return id_; }
+  template <typename Number>
+  static bool parseArgument(const std::string& text, Number& value) {
+    const char* end = text.data() + text.size();
+    auto parsed = std::from_chars(text.data(), end, value);
+    return !text.empty() && parsed.ec == std::errc() && parsed.ptr == end;
+  }
 
   /**
-   * @brief Mengambil nama playlist
+   * @brief Memecah baris perintah batch menjadi argumen
    *
-   * @return const std::string& Nama playlist
+   * Argumen dipisahkan spasi / tab, teks di dalam tanda kutip ganda menjadi
+   * satu argumen.
    */
-  std::string name() { return std::string(name_); }
+  static std::vector<std::string> splitCommand(const std::string& line) {
+    std::vector<std::string> args;
+    std::string current;
+    bool quoted = false, has_token = false;
+
+    for (char c : line) {
+      if (c == '"') {
+        quoted = !quoted;
+        has_token = true;
+      } else if (!quoted && (c == ' ' || c == '\t' || c == '\r')) {
+        if (has_token) args.push_back(std::move(current));
+        current.clear();
+        has_token = false;
+      } else {
+        current += c;
+        has_token = true;
+      }
+    }
+
+    if (has_token) args.push_back(std::move(current));
+    return args;
+  }
 
   /**
-   * @brief Mengambil daftar lagu dalam playlist
+   * @brief Menulis satu lagu sebagai baris TSV
    *
-   * @return LinkedList<Song>& Referensi ke LinkedList berisi lagu-lagu
    */
-  LinkedList<Song>& list() { return list_; }
+  static void writeSongRow(std::ostream& out, const Song& song) {
+    out << song.id << '\t' << song.title << '\t' << song.artist << '\t'
+        << song.genre << '\t' << song.release_year << '\t' << song.duration
+        << '\t' << song.play_count << '\n';
+  }
 
   /**
-   * @brief Menambahkan lagu ke dalam playlist
+   * @brief Mencari indeks playlist berdasarkan nama
    *
-   * @param song Lagu yang ingin ditambahkan
+   * @return size_t Indeks playlist, kNotPlaying jika tidak ditemukan
    */
-  void addSong(const Song& song) {
-    list_.push(song);
-    if (current_song_ == nullptr) {
-      current_song_ = list_.head();
+  size_t findPlaylist(const std::string& name) {
+    for (size_t i = 0; i < playlist_library.size(); i++) {
+      if (playlist_library.arr[i].name() == name) return i;
     }
+    return kNotPlaying;
   }
 
   /**
-   * @brief Menghapus lagu dari playlist
+   * @brief Menjalankan satu perintah batch
    *
-   * @param song Lagu yang akan dihapus
+   * @param args Nama perintah beserta argumennya
+   * @param number Nomor baris perintah (0 jika dari argumen program)
+   * @return true jika perintah berhasil
    */
-  void removeSong(const Song& song) { list_.deleteNode(song); }
+  bool executeCommand(const std::vector<std::string>& args, size_t number) {
+    auto fail = [&](const std::string& message) {
+      std::cerr << "error\t" << number << '\t' << message << '\n';
+      return false;
+    };
+    auto need = [&](size_t count) { return args.size() >= count; };
+    const std::string& command = args[0];
+    auto write_row = [](std::ostream& out) {
+      return [&out](const Song& song) {
+        writeSongRow(out, song);
+        return true;
+      };
+    };
+
+    if (command == "list") {
+      library.forEachSong(write_row(std::cout));
+    } else if (command == "get") {
+      if (!need(2)) return fail("get <id>");
+      size_t id;
+      if (!parseArgument(args[1], id)) {
+        return fail("ID tidak valid: " + args[1]);
+      }
+      Song song;
+      if (!library.findSong(id, song)) {
+        return fail("lagu " + args[1] + " tidak ditemukan");
+      }
+      writeSongRow(std::cout, song);
+    } else if (command == "count" && need(2) &&
+               args[1].find('=') != std::string::npos) {
+      SongQuery query;
+      std::string error;
+      for (size_t i = 1; i < args.size(); i++) {
+        if (!query.parse(args[i], error)) return fail(error);
+      }
+      std::cout << QueryEngine(library).count(query) << '\n';
+    } else if (command == "range" || command == "count") {
+      if (!need(4)) {
+        return fail(command + " <id|year|duration|plays> <min> <max>");
+      }
+      SongLibrary::RangeColumn column;
+      if (args[1] == "id") {
+        column = SongLibrary::RangeColumn::kId;
+      } else if (args[1] == "year") {
+        column = SongLibrary::RangeColumn::kYear;
+      } else if (args[1] == "duration") {
+        column = SongLibrary::RangeColumn::kDuration;
+      } else if (args[1] == "plays") {
+        column = SongLibrary::RangeColumn::kPlayCount;
+      } else {
+        return fail("kolom range tidak dikenal: " + args[1]);
+      }
 
-  /**
-   * @brief Operasi penyimpanan atribut playlist ke dalam file
-   *
-   * @return true jika playlist berhasil disimpan
-   */
-  bool serialize() const { return FileManager::write(name_, 255); }
+      long long low, high;
+      if (!parseArgument(args[2], low) || !parseArgument(args[3], high)) {
+        return fail("rentang tidak valid: " + args[2] + " " + args[3]);
+      }
+      if (command == "count") {
+        std::cout << library.countRange(column, low, high) << '\n';
+      } else {
+        library.scanRange(column, low, high, write_row(std::cout));
+      }
+    } else if (command == "query" || command == "explain") {
+      if (!need(2)) return fail(command + " <kolom=nilai>...");
+      SongQuery query;
+      std::string error;
+      for (size_t i = 1; i < args.size(); i++) {
+        if (!query.parse(args[i], error)) return fail(error);
+      }
 
-  /**
-   * @brief Operasi pembacaan atribut playlist dari file
-   *
-   * @return true jika seluruh pembacaan berjalan dengan baik
-   * @return false jika terjadi kegagalan dalam pembacaan file
-   */
-  bool deserialize() {
-    if (!FileManager::read(&name_[0], 255)) return false;
-    name_[254] = '\0';
+      QueryEngine engine(library);
+      if (command == "explain") {
+        QueryEngine::explain(engine.plan(query), std::cout);
+      } else {
+        engine.run(query, write_row(std::cout));
+      }
+    } else if (command == "search") {
+      if (!need(3)) return fail("search <title|artist|genre> <kata kunci>");
+      std::string keyword = args[2];
+      for (size_t i = 3; i < args.size(); i++) keyword += " " + args[i];
+
+      ArrayList<Song> found;
+      if (args[1] == "title") {
+        found = cariJudul(keyword);
+      } else if (args[1] == "artist") {
+        found = cariKolom(SongQuery::Field::kArtist, keyword);
+      } else if (args[1] == "genre") {
+        found = cariKolom(SongQuery::Field::kGenre, keyword);
+      } else {
+        return fail("kolom pencarian tidak dikenal: " + args[1]);
+      }
+
+      for (size_t i = 0; i < found.size(); i++) {
+        writeSongRow(std::cout, found.arr[i]);
+      }
+    } else if (command == "sort") {
+      if (!need(2)) return fail("sort <id|title|year|plays> [asc|desc]");
+      using SortColumn = SongLibrary::SortColumn;
+      SortColumn column;
+      if (args[1] == "id") {
+        column = SortColumn::kId;
+      } else if (args[1] == "title") {
+        column = SortColumn::kTitle;
+      } else if (args[1] == "year") {
+        column = SortColumn::kYear;
+      } else if (args[1] == "plays") {
+        column = SortColumn::kPlayCount;
+      } else {
+        return fail("kolom pengurutan tidak dikenal: " + args[1]);
+      }
+
+      SongView view = library.view(column, need(3) && args[2] == "desc");
+      for (size_t row = 0; row < view.size(); row++) {
+        writeSongRow(std::cout, view.at(row));
+      }
+    } else if (command == "import") {
+      if (!need(2)) return fail("import <file>");
+      SongImporter::Result result;
+      if (!SongImporter(library).importFile(args[1], result)) {
+        return fail("tidak dapat membuka " + args[1]);
+      }
+
+      library.markDirty();
+      std::cout << "ok\timport\t" << result.imported << '\t' << result.skipped
+                << '\n';
+    } else if (command == "export") {
+      if (!need(2)) return fail("export <file | ->");
+      std::ofstream file;
+      if (args[1] != "-") {
+        file.open(args[1]);
+        if (!file) return fail("tidak dapat menulis " + args[1]);
+      }
+
+      std::ostream& out = args[1] == "-" ? std::cout : file;
+      library.forEachSong(write_row(out));
+      if (args[1] != "-") std::cout << "ok\texport\t" << library.size() << '\n';
+    } else if (command == "playlists") {
+      for (size_t i = 0; i < playlist_library.size(); i++) {
+        Playlist& playlist = playlist_library.arr[i];
+        std::cout << playlist.id() << '\t' << playlist.name() << '\t'
+                  << playlist.count() << '\n';
+      }
+    } else if (command == "playlist-create") {
+      if (!need(2)) return fail("playlist-create <nama>");
+      if (findPlaylist(args[1]) != kNotPlaying) {
+        return fail("playlist " + args[1] + " sudah ada");
+      }
+
+      Playlist new_playlist(args[1]);
+      new_playlist.attach(persistence_);
+      playlist_library.add(new_playlist);
+      persistence_.schedule(FileManager::kPlaylist, playlist_library);
+      persistence_.schedule(new_playlist.filename(), new_playlist.list());
+      std::cout << "ok\tplaylist-create\t" << args[1] << '\n';
+    } else if (command == "playlist-add") {
+      if (!need(3)) return fail("playlist-add <nama> <id>...");
+      size_t index = findPlaylist(args[1]);
+      if (index == kNotPlaying) {
+        return fail("playlist " + args[1] + " tidak ada");
+      }
+
+      // Seluruh ID diperiksa dulu agar playlist tidak berubah sebagian
+      Playlist& playlist = openPlaylist(index);
+      std::vector<Song> songs;
+      std::unordered_set<size_t> pending;
+      for (size_t i = 2; i < args.size(); i++) {
+        size_t id;
+        if (!parseArgument(args[i], id)) {
+          return fail("ID tidak valid: " + args[i]);
+        }
+        if (playlist.contains(id) || !pending.insert(id).second) continue;
+        Song song;
+        if (!library.findSong(id, song)) {
+          return fail("lagu " + args[i] + " tidak ditemukan");
+        }
+        songs.push_back(song);
+      }
+
+      for (const Song& song : songs) playlist.addSong(song);
+      std::cout << "ok\tplaylist-add\t" << songs.size() << '\n';
+    } else if (command == "playlist-show") {
+      if (!need(2)) return fail("playlist-show <nama>");
+      size_t index = findPlaylist(args[1]);
+      if (index == kNotPlaying) {
+        return fail("playlist " + args[1] + " tidak ada");
+      }
+
+      Playlist& playlist = openPlaylist(index);
+      for (auto* node = playlist.list().head(); node; node = node->next) {
+        writeSongRow(std::cout, node->data);
+      }
+    } else if (command == "cache") {
+      SongCache& cache = library.cache();
+      std::cout << cache.size() << '\t' << cache.capacity() << '\t'
+                << cache.hits() << '\t' << cache.misses() << '\n';
+    } else if (command == "metrics") {
+      if (args.size() < 2 || args[1] == "-") {
+        Metrics::writeJson(std::cout);
+      } else {
+        std::ofstream file(args[1]);
+        if (!file) return fail("tidak dapat menulis " + args[1]);
+        Metrics::writeJson(file);
+        std::cout << "ok\tmetrics\t" << args[1] << '\n';
+      }
+    } else if (command == "help" || command == "--help") {
+      printUsage(std::cout);
+    } else {
+      return fail("perintah tidak dikenal: " + command);
+    }
 
-    Playlist::id_counter++;
     return true;
   }
 
   /**
-   * @brief Menampilkan daftar lagu dalam bentuk tabel yang terformat
+   * @brief Menyimpan seluruh perubahan setelah mode batch selesai
    *
+   * @return true jika seluruh perubahan sudah tertulis ke disk
    */
-  void displayList() {
-    Node<Song>* x = list_.head();
-
-    std::cout << "\n\n"
-              << std::setfill('-') << std::setw(61) << "-" << std::setfill(' ')
-              << "\n";
-    ;
-    std::cout << std::left << std::setw(5 + Text::kAnsi) << Text::bold("ID")
-              << std::setw(18 + Text::kAnsi) << Text::bold("Judul")
-              << std::setw(18 + Text::kAnsi) << Text::bold("Artis")
-              << std::setw(8 + Text::kAnsi) << Text::bold("Tahun")
-              << std::setw(8 + Text::kAnsi) << Text::bold("Durasi")
-              << std::setw(15 + Text::kAnsi) << Text::bold("Diputar") << "\n";
+  bool finishBatch() {
+    bool ok = persistChanges();
+    ok = persistence_.flush() && ok;
+    ok = song_store_.flush() && ok;
+    std::cout.flush();
+    return ok;
+  }
 
-    std::cout << std::setfill('-') << std::setw(61) << "-" << std::setfill(' ')
-              << "\n";
+  /**
+   * @brief Memuat indeks playlist (nama, id, dan jumlah lagu) tanpa isinya
+   *
+   */
+  void loadPlaylistIndex() {
+    FileManager::load(FileManager::kPlaylist, playlist_library);
 
-    while (x != nullptr) {
-      std::cout << std::left << std::setw(5) << x->data.id << std::setw(18)
-                << std::string(x->data.title).substr(0, 17) << std::setw(18)
-                << std::string(x->data.artist).substr(0, 17) << std::setw(8)
-                << x->data.release_year << std::setw(8) << x->data.duration
-                << std::setw(15) << x->data.play_count << "\n";
-      x = x->next;
+    last_access_.assign(playlist_library.size(), 0);
+    for (size_t i = 0; i < playlist_library.size(); i++) {
+      playlist_library.arr[i].attach(persistence_);
+      playlist_library.arr[i].scanCount();
     }
-    std::cout << "\n\n";
   }
 
   /**
-   * @brief Menampilkan animasi seolah sedang memutar lagu dari playlist
+   * @brief Memuat isi playlist secara paralel selama muat dalam batas memori
    *
+   * Perkiraan memori dihitung dari jumlah lagu (ukuran file), playlist sisanya
+   * tetap dimuat saat pertama kali dibuka.
+   *
+   * @param pool Thread pool tempat playlist dimuat
    */
-  void playbackLoop(bool& display) {
-    current_song_ = list_.head();
-
-    while (current_song_) {
-      int remaining = current_song_->data.duration / 10;
-      std::string title = std::strcat(current_song_->data.title, "        ");
-      size_t move_print = 0;
-
-      int tick{0};
-      while (remaining > 0) {
-        std::cout << "\033[s";
-        std::cout << "\033[2;24H";
-
-        std::string scrolling_title = title.substr(move_print, 8);
-        if (scrolling_title.length() < 8) {
-          scrolling_title += title.substr(0, 8 - scrolling_title.length());
-        }
-
-        if (display) {
-          std::cout << "Now Playing: " << scrolling_title
-                    << " | Remaining: " << std::setw(3) << remaining << "s"
-                    << std::flush;
-        }
-
-        std::cout << "\033[u" << std::flush;
-
-        std::this_thread::sleep_for(std::chrono::milliseconds(200));
-
-        if (tick % 5 == 0) {
-          --remaining;
-          tick = 0;
-        }
-
-        tick++;
-        move_print = (move_print + 1) % title.length();  // wrap scroll
-      }
+  void preloadPlaylists(TaskPool& pool) {
+    size_t estimated = 0;
+    for (size_t i = 0; i < playlist_library.size(); i++) {
+      Playlist& playlist = playlist_library.arr[i];
+      size_t bytes = playlist.count() * sizeof(IndexedList<Song>::NodeType);
+      if (estimated + bytes > playlist_budget_) continue;
 
-      nextSong();
+      estimated += bytes;
+      pool.submit([&playlist] { playlist.ensureLoaded(); });
     }
   }
 
- private:
-  char name_[255];           /**< Nama playlist */
-  size_t id_;                /**< ID unik dari playlist */
-  LinkedList<Song> list_;    /**< Daftar lagu dalam bentuk LinkedList */
-  Node<Song>* current_song_; /**< Pointer ke lagu yang sedang diputar */
-
   /**
-   * @brief Mengganti current_song ke lagu selanjutnya dalam list
+   * @brief Membuka playlist dan memastikan isinya berada di memori
+   *
+   * Playlist yang dibuka ditandai sebagai yang terakhir diakses. Jika total
+   * isi playlist yang dimuat melebihi batas memori, playlist yang paling lama
+   * tidak diakses akan dikeluarkan dari memori (kecuali yang sedang diputar).
    *
+   * @param index Indeks playlist yang ingin dibuka
+   * @return Playlist& Referensi playlist yang sudah dimuat
    */
-  void nextSong() {
-    if (current_song_ && current_song_->next) {
-      current_song_ = current_song_->next;
-    } else {
-      current_song_ = list_.head();
-    }
+  Playlist& openPlaylist(size_t index) {
+    Playlist& playlist = playlist_library.arr[index];
+    playlist.ensureLoaded();
+    last_access_.resize(playlist_library.size(), 0);
+    last_access_[index] = ++access_clock_;
+
+    enforcePlaylistBudget(index);
+    return playlist;
   }
-};
-
-/// Inisialisasi static variabel
-size_t Song::id_counter = 1;
-size_t Playlist::id_counter = 1;
-int SongSearcher::result_index = -1;
 
-/**
- * @class RAiVFY
- * @brief Kelas utama yang mengatur seluruh fungsionalitas aplikasi RAiVFY.
- *
- * Kelas ini menangani antarmuka pengguna, pemutaran playlist, pengelolaan lagu,
- * pencarian lagu, serta manajemen file untuk penyimpanan data.
- */
-class RAiVFY {
- public:
   /**
-   * @brief Memulai aplikasi RAiVFY.
+   * @brief Mengeluarkan playlist LRU hingga pemakaian memori sesuai batas
    *
-   * Jika terdapat playlist, lagu akan langsung diputar di thread terpisah.
-   * Setelah itu, program menampilkan menu utama.
+   * @param keep Indeks playlist yang tidak boleh dikeluarkan
    */
-  void ignite() {
-    size_t index = 0;
-    isLogin = isAdmin = isPlaying = false;
-    bool display = false;
-
+  void enforcePlaylistBudget(size_t keep) {
     while (true) {
-      if (!isLogin) {
-        isLogin = login();
-        continue;
-      }
-
-      if (isAdmin) {
-        display = false;
-        menuAdmin();
-        continue;
-      }
+      size_t resident = 0;
+      size_t victim = kNotPlaying;
 
-      if (!playlist_library.empty() && !isPlaying) {
-        display = true;
+      for (size_t i = 0; i < playlist_library.size(); i++) {
+        Playlist& playlist = playlist_library.arr[i];
+        if (!playlist.isLoaded()) continue;
 
-        while (index < playlist_library.size() - 1 &&
-               playlist_library.arr[index].list().isEmpty()) {
-          index++;
+        resident += playlist.residentBytes();
+        if (i == keep || i == playing_index_) continue;
+        if (victim == kNotPlaying || last_access_[i] < last_access_[victim]) {
+          victim = i;
         }
-
-        std::thread playback(&Playlist::playbackLoop,
-                             &playlist_library.arr[index], std::ref(display));
-        playback.detach();
-        isPlaying = true;
       }
 
-      mainMenu();
-    }
-  }
-
-  /**
-   * @brief Memuat data dari file eksternal ke dalam memori.
-   *
-   * Memuat daftar lagu dan playlist dari file menggunakan FileManager.
-   */
-  void load() {
-    FileManager::load<Song>(FileManager::kDatabase, library.database());
-    FileManager::load<Playlist>(FileManager::kPlaylist, playlist_library);
-
-    for (size_t i = 0; i < playlist_library.size(); i++) {
-      FileManager::load<Song>(playlist_library.arr[i].name() + ".dat",
-                              playlist_library.arr[i].list());
+      if (resident <= playlist_budget_ || victim == kNotPlaying) return;
+      playlist_library.arr[victim].evict();
     }
   }
-
- private:
-  SongLibrary library; /**< Objek untuk mengatur seluruh operasi database */
-  ArrayList<Playlist>
-      playlist_library; /** Koleksi playlist yang dimiliki user */
-  bool isAdmin,
-      isLogin;    /**< Menentukan user login atau belum & admin atau bukan */
-  bool isPlaying; /**< Playback status */
   /**
    * @brief Menampilkna menu utama kepada pengguna
    *
@@ -1296,9 +9487,10 @@ class RAiVFY {
     std::cout << " 2.  Lihat Playlist\n";
     std::cout << " 3.  Daftar Lagu\n";
     std::cout << " 4.  Cari Lagu\n";
+    std::cout << " 5.  Kontrol Pemutaran\n";
     std::cout << " 0.  Keluar\n\n";
 
-    enum mainMenu { KELUAR, BUAT, LIHAT, LIST, SEARCH };
+    enum mainMenu { KELUAR, BUAT, LIHAT, LIST, SEARCH, PEMUTARAN };
 
     int choice = getNumberInput<int>(Text::bold(" > Pilih Menu : "));
 
@@ -1312,10 +9504,11 @@ class RAiVFY {
         int choice = getNumberInput<int>("\n > Ketik input: ");
         switch (choice) {
           case LOGIN:
+            flushPlaylists();
             isLogin = false;
             break;
           case EXIT:
-            exit(0);
+            exit(shutdown() ? 0 : 1);
             break;
         }
         break;
@@ -1332,6 +9525,120 @@ class RAiVFY {
       case SEARCH:
         searchingLagu();
         break;
+      case PEMUTARAN:
+        kontrolPemutaran();
+        break;
+      default:
+        std::cout << " Pilihan menu tidak tersedia!\n";
+    }
+  }
+
+  /**
+   * @brief Mengambil nama mode ulang untuk ditampilkan
+   *
+   */
+  static const char* repeatLabel(PlaybackEngine::RepeatMode mode) {
+    switch (mode) {
+      case PlaybackEngine::RepeatMode::kAll:
+        return "Semua";
+      case PlaybackEngine::RepeatMode::kOne:
+        return "Satu lagu";
+      case PlaybackEngine::RepeatMode::kOff:
+        return "Mati";
+    }
+    return "-";
+  }
+
+  /**
+   * @brief Mengambil nama mode acak untuk ditampilkan
+   *
+   */
+  static const char* shuffleLabel(PlaybackEngine::ShuffleMode mode) {
+    switch (mode) {
+      case PlaybackEngine::ShuffleMode::kOff:
+        return "Mati";
+      case PlaybackEngine::ShuffleMode::kOn:
+        return "Acak";
+      case PlaybackEngine::ShuffleMode::kSmart:
+        return "Acak pintar";
+    }
+    return "-";
+  }
+
+  /**
+   * @brief Menampilkan menu kontrol pemutaran playlist
+   *
+   */
+  void kontrolPemutaran() {
+    clearScreen();
+    printBorder(Text::bold(" Kontrol Pemutaran "), 11);
+
+    std::cout << "\n Playlist: "
+              << (playing_index_ == kNotPlaying
+                      ? std::string("-")
+                      : playlist_library.arr[playing_index_].name())
+              << (playback_.isPaused(session_) ? " (dijeda)" : "") << "\n";
+    std::cout << " 1. Jeda\n";
+    std::cout << " 2. Lanjutkan\n";
+    std::cout << " 3. Lagu berikutnya\n";
+    std::cout << " 4. Hentikan\n";
+    std::cout << " 5. Putar playlist lain\n";
+    std::cout << " 6. Mode ulang: "
+              << repeatLabel(playback_.repeatMode(session_)) << "\n";
+    std::cout << " 7. Mode acak: "
+              << shuffleLabel(playback_.shuffleMode(session_)) << "\n";
+    std::cout << " 0. Kembali\n\n";
+
+    enum kontrol { KEMBALI, JEDA, LANJUT, SKIP, STOP, GANTI, ULANG, ACAK };
+
+    switch (getNumberInput<int>(" > Pilih menu: ")) {
+      case KEMBALI:
+        break;
+      case JEDA:
+        playback_.pause(session_);
+        break;
+      case LANJUT:
+        playback_.resume(session_);
+        break;
+      case SKIP:
+        playback_.skip(session_);
+        break;
+      case STOP:
+        stopPlayback();
+        stopped_by_user_ = true;
+        break;
+      case GANTI: {
+        size_t choice = getNumberInput<size_t>(" ID playlist: ");
+        if (choice == 0 || choice > playlist_library.size()) {
+          std::cout << " Tidak ada playlist yang sesuai!\n";
+          std::cin.ignore();
+          waitForInput();
+          break;
+        }
+
+        startPlayback(choice - 1);
+        break;
+      }
+      case ULANG: {
+        using RepeatMode = PlaybackEngine::RepeatMode;
+        RepeatMode mode = playback_.repeatMode(session_);
+        playback_.setRepeat(session_, mode == RepeatMode::kAll
+                                          ? RepeatMode::kOne
+                                      : mode == RepeatMode::kOne
+                                          ? RepeatMode::kOff
+                                          : RepeatMode::kAll);
+        break;
+      }
+      case ACAK: {
+        using ShuffleMode = PlaybackEngine::ShuffleMode;
+        ShuffleMode mode = playback_.shuffleMode(session_);
+        playback_.setShuffle(session_, mode == ShuffleMode::kOff
+                                           ? ShuffleMode::kOn
+                                       : mode == ShuffleMode::kOn
+                                           ? ShuffleMode::kSmart
+                                           : ShuffleMode::kOff);
+        break;
+      }
       default:
         std::cout << " Pilihan menu tidak tersedia!\n";
     }
@@ -1362,9 +9669,10 @@ class RAiVFY {
                 << "] sudah ada!\n";
     } else {
       Playlist new_playlist(namaPlaylist);
+      new_playlist.attach(persistence_);
       playlist_library.add(new_playlist);
-      FileManager::save(FileManager::kPlaylist, playlist_library);
-      FileManager::save(namaPlaylist + ".dat", new_playlist.list());
+      persistence_.schedule(FileManager::kPlaylist, playlist_library);
+      persistence_.schedule(new_playlist.filename(), new_playlist.list());
 
       std::cout << "\n Playlist [" << Text::bold(namaPlaylist)
                 << "] berhasil dibuat!\n";
@@ -1387,8 +9695,8 @@ class RAiVFY {
     for (size_t i = 0; i < playlist_library.size(); i++) {
       Playlist& playlist = playlist_library.arr[i];
       std::cout << " " << playlist.id() << ". " << std::left << std::setw(15)
-                << playlist.name().substr(0, 14) << "("
-                << playlist.list().count() << " songs)"
+                << playlist.name().substr(0, 14) << "(" << playlist.count()
+                << " songs)"
                 << "\n";
     }
     std::cout << "\n 0. Kembali ke Main Menu\n";
@@ -1417,6 +9725,8 @@ class RAiVFY {
       return;
     }
 
+    openPlaylist(index);
+
     printBorder(
         " Playlist [" + Text::bold(playlist_library.arr[index].name()) + "] ",
         12);
@@ -1426,9 +9736,18 @@ class RAiVFY {
     std::cout << " 3. Hapus lagu dari playlist\n";
     std::cout << " 4. Hapus playlist\n";
     std::cout << " 5. Reverse playlist\n";
+    std::cout << " 6. Pindahkan posisi lagu\n";
     std::cout << " 0. Kembali ke menu utama\n\n";
 
-    enum action { KEMBALI, LIHAT, TAMBAH, HAPUS_LAGU, HAPUS_PLAYLIST, REVERSE };
+    enum action {
+      KEMBALI,
+      LIHAT,
+      TAMBAH,
+      HAPUS_LAGU,
+      HAPUS_PLAYLIST,
+      REVERSE,
+      PINDAH
+    };
 
     int choice = getNumberInput<int>(" > Pilih menu: ");
     switch (choice) {
@@ -1454,20 +9773,21 @@ class RAiVFY {
       }
       case TAMBAH: {
         isPlaying = true;
-        ArrayList<Song> filtered = searchingLagu();
+        bool show_all = false;
+        ArrayList<Song> filtered = searchingLagu(&show_all);
 
         size_t selected_id = getNumberInput<size_t>(" Masukan ID lagu : ");
-        if (SongSearcher::binarySearch(selected_id, filtered)) {
+        Song selected;
+        if (playlist_library.arr[index].contains(selected_id)) {
+          std::cout << " Lagu sudah ada di playlist!\n";
+          std::cin.ignore();
+          waitForInput();
+        } else if (show_all && library.findSong(selected_id, selected)) {
+          playlist_library.arr[index].addSong(selected);
+        } else if (SongSearcher::binarySearch(selected_id, filtered)) {
           playlist_library.arr[index].addSong(
               filtered.arr[SongSearcher::result_index]);
         }
-
-        FileManager::save(playlist_library.arr[index].name() + ".dat",
-                          playlist_library.arr[index].list());
-
-        playlist_library.arr[index].list().clear();
-        FileManager::load(playlist_library.arr[index].name() + ".dat",
-                          playlist_library.arr[index].list());
         break;
       }
       case HAPUS_LAGU: {
@@ -1481,41 +9801,38 @@ class RAiVFY {
         playlist_library.arr[index].displayList();
 
         size_t selected_id = getNumberInput<size_t>(" Masukan ID lagu : ");
-        if (SongSearcher::binarySearch(selected_id, library.database())) {
-          playlist_library.arr[index].removeSong(
-              library.database().arr[SongSearcher::result_index]);
+        if (!playlist_library.arr[index].removeSongById(selected_id)) {
+          std::cout << " Lagu tidak ada di playlist!\n";
+          std::cin.ignore();
+          waitForInput();
         }
-
-        FileManager::save(playlist_library.arr[index].name() + ".dat",
-                          playlist_library.arr[index].list());
-
-        playlist_library.arr[index].list().clear();
-        FileManager::load(playlist_library.arr[index].name() + ".dat",
-                          playlist_library.arr[index].list());
         break;
       }
       case HAPUS_PLAYLIST: {
+        stopPlayback();
         deleteFilePlaylist(index);
 
         size_t target = playlist_library.arr[index].id();
 
         for (size_t i = 0; i < playlist_library.size(); i++) {
           if (playlist_library.arr[i].id() == target) {
-            for (size_t j = i; j < playlist_library.size(); j++) {
-              playlist_library.arr[j] = playlist_library.arr[j + 1];
+            for (size_t j = i; j + 1 < playlist_library.size(); j++) {
+              playlist_library.arr[j] = std::move(playlist_library.arr[j + 1]);
             }
             playlist_library.decreaseSize();
           }
         }
 
-        FileManager::save(FileManager::kPlaylist, playlist_library);
+        persistence_.schedule(FileManager::kPlaylist, playlist_library);
+        flushPlaylists();
+        persistence_.flush();
 
         Playlist::id_counter = 1;
-        FileManager::load(FileManager::kPlaylist, playlist_library);
+        loadPlaylistIndex();
         break;
       }
       case REVERSE: {
-        playlist_library.arr[index].list().reverse();
+        playlist_library.arr[index].reverse();
         if (!playlist_library.arr[index].list().isEmpty()) {
           playlist_library.arr[index].displayList();
         } else {
@@ -1526,6 +9843,29 @@ class RAiVFY {
         waitForInput();
         break;
       }
+      case PINDAH: {
+        Playlist& playlist = playlist_library.arr[index];
+        if (playlist.list().isEmpty()) {
+          std::cout << "\n Playlist masih kosong!\n";
+          std::cin.ignore();
+          waitForInput();
+          break;
+        }
+
+        playlist.displayList();
+
+        size_t from = getNumberInput<size_t>(" Urutan lagu yang dipindah : ");
+        size_t to = getNumberInput<size_t>(" Pindahkan ke urutan      : ");
+        if (from == 0 || to == 0 || !playlist.moveSong(from - 1, to - 1)) {
+          std::cout << " Urutan lagu tidak valid!\n";
+        } else {
+          playlist.displayList();
+        }
+
+        std::cin.ignore();
+        waitForInput();
+        break;
+      }
       default:
         std::cout << " Pilihan menu tidak tersedia!\n";
     }
@@ -1539,67 +9879,60 @@ class RAiVFY {
    * @param data ArrayList berisi lagu-lagu yang ingin ditampilkan.
    */
   void daftarLagu() {
-    clearScreen();
-
-    printBorder(Text::bold(" Daftar Lagu "), library.database().size() + 3);
-    if (library.database().empty()) {
-      std::cout << "Database masih kosong!\n";
-      std::cin.ignore();
-      waitForInput();
-      return;
-    }
+    using SortColumn = SongLibrary::SortColumn;
+    SongView view = library.view();
 
-    tabelLagu(library.database(), false);
-
-    std::cout << "\n Ingin mengurutkan berdasarkan:\n";
-    std::cout << " 1. Tahun Rilis\n";
-    std::cout << " 2. Most Played\n";
-    std::cout << " 3. Judul\n";
-    std::cout << " 0. Kembali\n\n";
+    while (true) {
+      clearScreen();
+      if (library.size() == 0) {
+        printBorder(Text::bold(" Daftar Lagu "), 3);
+        std::cout << "Database masih kosong!\n";
+        std::cin.ignore();
+        waitForInput();
+        return;
+      }
 
-    int isDescending{0};
+      tabelLagu(view, false, " Daftar Lagu ");
 
-    int pilihan = getNumberInput<int>(" > Pilih menu: ");
-    switch (pilihan) {
-      case 1:
-        isDescending = opsiSorting() - 1;
+      std::cout << " " << Text::bold("Terpopuler:");
+      for (const PlayRank& rank : library.topPlayed()) {
+        std::cout << " " << rank.title.substr(0, 17) << " (" << rank.play_count
+                  << "x)";
+      }
+      std::cout << "\n";
 
-        SongSorter::quickSort(
-            library.database(), 0, library.database().size() - 1,
-            (isDescending)
-                ? SongSorter::reverseOrder<Song>(SongSorter::by_release_year)
-                : SongSorter::by_release_year);
+      std::cout << "\n Ingin mengurutkan berdasarkan:\n";
+      std::cout << " 1. Tahun Rilis\n";
+      std::cout << " 2. Most Played\n";
+      std::cout << " 3. Judul\n";
+      std::cout << " 0. Kembali\n\n";
 
-        daftarLagu();
-        break;
-      case 2:
-        isDescending = opsiSorting() - 1;
+      int isDescending{0};
 
-        SongSorter::quickSort(
-            library.database(), 0, library.database().size() - 1,
-            (isDescending)
-                ? SongSorter::reverseOrder<Song>(SongSorter::by_play_count)
-                : SongSorter::by_play_count);
+      int pilihan = getNumberInput<int>(" > Pilih menu: ");
+      switch (pilihan) {
+        case 1:
+          isDescending = opsiSorting() - 1;
 
-        daftarLagu();
-        break;
-      case 3:
-        isDescending = opsiSorting() - 1;
+          view = library.view(SortColumn::kYear, isDescending);
+          break;
+        case 2:
+          isDescending = opsiSorting() - 1;
 
-        SongSorter::quickSort(
-            library.database(), 0, library.database().size() - 1,
-            (isDescending)
-                ? SongSorter::reverseOrder<Song>(SongSorter::by_title)
-                : SongSorter::by_title);
+          view = library.view(SortColumn::kPlayCount, isDescending);
+          break;
+        case 3:
+          isDescending = opsiSorting() - 1;
 
-        daftarLagu();
-        break;
-      case 0:
-        return;
-        break;
-      default:
-        std::cout << " Pilihan menu tidak tersedia!\n";
-        break;
+          view = library.view(SortColumn::kTitle, isDescending);
+          break;
+        case 0:
+          return;
+          break;
+        default:
+          std::cout << " Pilihan menu tidak tersedia!\n";
+          return;
+      }
     }
   }
 
@@ -1608,32 +9941,98 @@ class RAiVFY {
    *
    * @param data
    */
-  void tabelLagu(ArrayList<Song>& data, bool display_id = true) {
+  void tabelLagu(ArrayList<Song>& data, bool display_id = true,
+                 const std::string& title = "") {
+    SongView view(data);
+    tabelLagu(view, display_id, title);
+  }
+
+  /**
+   * @brief Menampilkan tabel lagu per halaman (virtualized)
+   *
+   * Hanya baris pada halaman yang terlihat yang diformat, sehingga biaya
+   * render sebanding dengan tinggi layar, bukan jumlah lagu. Jika lagu lebih
+   * dari satu halaman, pengguna dapat berpindah halaman atau melompat ke baris
+   * tertentu.
+   *
+   * @param view Urutan lagu yang ditampilkan
+   * @param display_id Menampilkan kolom ID atau tidak
+   * @param title Judul tabel
+   */
+  void tabelLagu(const SongView& view, bool display_id = true,
+                 const std::string& title = "") {
+    const size_t page_rows = static_cast<size_t>(
+        std::max(kMinPageRows, Screen::terminalRows() - kPageChrome));
+    const size_t total = view.size();
+    const size_t pages =
+        std::max<size_t>(1, (total + page_rows - 1) / page_rows);
+    size_t page = 0;
+
     clearScreen();
-    std::cout << "\n\n"
-              << std::setfill('-') << std::setw(61) << "-" << std::setfill(' ')
-              << "\n";
-    std::cout << std::left << std::setw(5 + Text::kAnsi) << Text::bold("No")
-              << std::setw(18 + Text::kAnsi) << Text::bold("Judul")
-              << std::setw(18 + Text::kAnsi) << Text::bold("Artis");
-    if (display_id) std::cout << std::setw(5 + Text::kAnsi) << Text::bold("ID");
-    std::cout << std::setw(8 + Text::kAnsi) << Text::bold("Tahun")
-              << std::setw(8 + Text::kAnsi) << Text::bold("Durasi")
-              << std::setw(15 + Text::kAnsi) << Text::bold("Diputar") << "\n";
-    std::cout << std::setfill('-') << std::setw(61) << "-" << std::setfill(' ')
-              << "\n";
+    while (true) {
+      size_t first = page * page_rows;
+      size_t last = std::min(total, first + page_rows);
+
+      Frame frame(page_rows + kPageChrome);
+      if (!title.empty()) {
+        frame.rule(23).text(Text::bold(title));
+        frame.rule(title.size() < 38 ? 38 - title.size() : 0).endLine();
+      } else {
+        frame.endLine();
+      }
+      frame.endLine().rule(61).endLine();
+      frame.boldCell("No", 5).boldCell("Judul", 18).boldCell("Artis", 18);
+      if (display_id) frame.boldCell("ID", 5);
+      frame.boldCell("Tahun", 8)
+          .boldCell("Durasi", 8)
+          .boldCell("Diputar", 15)
+          .endLine();
+      frame.rule(61).endLine();
+
+      for (size_t row = first; row < last; row++) {
+        const Song& song = view.at(row);
+        frame.cell(row + 1, 5).cell(song.title, 18).cell(song.artist, 18);
+        if (display_id) frame.cell(song.id, 5);
+        frame.cell(static_cast<long long>(song.release_year), 8)
+            .cell(song.duration, 8)
+            .cell(song.play_count, 12)
+            .endLine();
+      }
+      frame.endLine();
 
-    for (size_t index = 0; index < data.size(); index++) {
-      auto& song = data.arr[index];
-      std::cout << std::left << std::setw(5) << index + 1 << std::setw(18)
-                << std::string(song.title).substr(0, 17) << std::setw(18)
-                << std::string(song.artist).substr(0, 17);
-      if (display_id) std::cout << std::setw(5) << song.id;
-      std::cout << std::setw(8) << song.release_year << std::setw(8)
-                << song.duration << std::setw(12) << song.play_count << "\n";
-    }
+      if (pages == 1) {
+        frame.endLine();
+        screen_.present(std::move(frame));
+        return;
+      }
 
-    std::cout << "\n\n";
+      char status[96];
+      int length = std::snprintf(status, sizeof(status),
+                                 " Halaman %zu/%zu (baris %zu-%zu dari %zu)",
+                                 page + 1, pages, first + 1, last, total);
+      frame.text(std::string_view(status, static_cast<size_t>(length)))
+          .endLine();
+      frame.text(" [n] Berikutnya  [p] Sebelumnya  [g] Ke baris  [q] Selesai")
+          .endLine();
+      screen_.present(std::move(frame));
+
+      std::cout << " > ";
+      std::string command;
+      if (!(std::cin >> command)) return;
+      // Sisa baris (termasuk newline) dibuang agar waitForInput() berikutnya
+      // benar-benar menunggu enter
+      std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+      if (command == "q") return;
+
+      if (command == "n" && page + 1 < pages) {
+        page++;
+      } else if (command == "p" && page > 0) {
+        page--;
+      } else if (command == "g") {
+        size_t row = getNumberInput<size_t>(" Baris: ");
+        if (row >= 1 && row <= total) page = (row - 1) / page_rows;
+      }
+    }
   }
 
   /**
@@ -1653,9 +10052,14 @@ class RAiVFY {
   /**
    * @brief Menampilkan menu pencarian lagu
    *
+   * Opsi "Show All" tidak menyalin seluruh database ke hasil pencarian,
+   * melainkan mengisi show_all sehingga pemanggil dapat mencari lagu
+   * langsung di database.
+   *
+   * @param show_all Diisi true jika pengguna memilih "Show All" (opsional)
    * @return ArrayList<Song> ArrayList berisi lagu hasil pencarian
    */
-  ArrayList<Song> searchingLagu() {
+  ArrayList<Song> searchingLagu(bool* show_all = nullptr) {
     clearScreen();
     SongSearcher::result_index = -1;
     printBorder(Text::bold(" Search Lagu "), 11);
@@ -1663,10 +10067,12 @@ class RAiVFY {
     std::cout << " 1. Judul\n";
     std::cout << " 2. Artist\n";
     std::cout << " 3. Genre\n";
-    std::cout << " 4. Show All\n\n";
+    std::cout << " 4. Show All\n";
+    std::cout << " 5. Rentang Tahun Rilis\n";
+    std::cout << " 6. Rentang Durasi\n\n";
 
     int choice = getNumberInput<int>(Text::bold(" > Pilih metode : ")) - 1;
-    enum search { JUDUL, ARTIST, GENRE, ALL };
+    enum search { JUDUL, ARTIST, GENRE, ALL, TAHUN, DURASI };
     ArrayList<Song> filtered;
     switch (choice) {
       case JUDUL: {
@@ -1675,11 +10081,10 @@ class RAiVFY {
         std::string kata_kunci;
         std::cin.ignore();
         std::getline(std::cin, kata_kunci);
-        filtered = SongSearcher::searchByTitle(kata_kunci, library.database());
+        filtered = cariJudul(kata_kunci);
 
-        printBorder(Text::bold(" Search by [Title] "), filtered.size() + 5);
         if (!filtered.empty()) {
-          tabelLagu(filtered);
+          tabelLagu(filtered, true, " Search by [Title] ");
           waitForInput();
         } else {
           clearScreen();
@@ -1695,10 +10100,9 @@ class RAiVFY {
         std::string kata_kunci;
         std::cin.ignore();
         std::getline(std::cin, kata_kunci);
-        filtered = SongSearcher::searchByArtist(kata_kunci, library.database());
-        printBorder(Text::bold(" Search by [Artist] "), filtered.size() + 5);
+        filtered = cariKolom(SongQuery::Field::kArtist, kata_kunci);
         if (!filtered.empty()) {
-          tabelLagu(filtered);
+          tabelLagu(filtered, true, " Search by [Artist] ");
           waitForInput();
         } else {
           clearScreen();
@@ -1714,10 +10118,9 @@ class RAiVFY {
         std::string kata_kunci;
         std::cin.ignore();
         std::getline(std::cin, kata_kunci);
-        filtered = SongSearcher::searchByGenre(kata_kunci, library.database());
-        printBorder(Text::bold(" Search by [Genre] "), filtered.size() + 5);
+        filtered = cariKolom(SongQuery::Field::kGenre, kata_kunci);
         if (!filtered.empty()) {
-          tabelLagu(filtered);
+          tabelLagu(filtered, true, " Search by [Genre] ");
           waitForInput();
         } else {
           clearScreen();
@@ -1728,10 +10131,9 @@ class RAiVFY {
         break;
       }
       case ALL:
-        filtered = library.database();
-        printBorder(Text::bold(" Show All Songs "), filtered.size() + 5);
-        if (!filtered.empty()) {
-          tabelLagu(library.database());
+        if (show_all) *show_all = true;
+        if (library.size() != 0) {
+          tabelLagu(library.view(), true, " Show All Songs ");
           waitForInput();
         } else {
           clearScreen();
@@ -1740,6 +10142,14 @@ class RAiVFY {
         }
         std::cin.ignore();
         break;
+      case TAHUN:
+        filtered = cariRentang(SongLibrary::RangeColumn::kYear, "tahun",
+                               " Search by [Year] ");
+        break;
+      case DURASI:
+        filtered = cariRentang(SongLibrary::RangeColumn::kDuration,
+                               "durasi (detik)", " Search by [Duration] ");
+        break;
       default:
         std::cout << " Pilihan menu tidak tersedia!";
     }
@@ -1748,24 +10158,93 @@ class RAiVFY {
   }
 
   /**
-   * @brief Membersihkan layar terminal sesuai sistem operasi
+   * @brief Mencari lagu dengan judul yang sama persis (tanpa membedakan huruf
+   * besar / kecil)
+   *
+   * Seluruh lagu ditelusuri satu per satu (juga di SongStore), hanya lagu
+   * yang cocok yang disalin.
    *
+   * @return ArrayList<Song> Lagu yang cocok
    */
-  void clearScreen() {
-#ifdef __WIN32__
-    system("cls");
-#else
-    system("clear");
-#endif
+  ArrayList<Song> cariJudul(const std::string& keyword) {
+    RAIVFY_TIMED(kSearch);
+    std::string normalized = SongSearcher::normalizeString(keyword.c_str());
+
+    ArrayList<Song> found;
+    library.forEachSong([&](const Song& song) {
+      if (SongSearcher::normalizeString(song.title) == normalized) {
+        found.add(song);
+      }
+      return true;
+    });
+    return found;
+  }
+
+  /**
+   * @brief Mencari lagu dengan artis / genre yang sama persis (bitmap index)
+   *
+   * @return ArrayList<Song> Lagu yang cocok, terurut berdasarkan ID
+   */
+  ArrayList<Song> cariKolom(SongQuery::Field field,
+                            const std::string& keyword) {
+    SongQuery query;
+    query.where(field, keyword);
+
+    ArrayList<Song> found;
+    QueryEngine(library).run(query, [&found](const Song& song) {
+      found.add(song);
+      return true;
+    });
+    return found;
+  }
+
+  /**
+   * @brief Mencari lagu dengan nilai kolom dalam rentang yang diinput user
+   *
+   * @param column Kolom yang dicari (memakai index terurut SongLibrary)
+   * @param label Nama kolom pada prompt
+   * @param title Judul tabel hasil pencarian
+   * @return ArrayList<Song> Lagu dalam rentang, terurut berdasarkan kolom
+   */
+  ArrayList<Song> cariRentang(SongLibrary::RangeColumn column,
+                              const std::string& label,
+                              const std::string& title) {
+    long long low = getNumberInput<long long>(" Dari " + label + "   : ");
+    long long high = getNumberInput<long long>(" Sampai " + label + " : ");
+
+    ArrayList<Song> filtered;
+    filtered.reserve(library.countRange(column, low, high));
+    library.scanRange(column, low, high, [&filtered](const Song& song) {
+      filtered.add(song);
+      return true;
+    });
+
+    std::cin.ignore();
+    if (!filtered.empty()) {
+      tabelLagu(filtered, true, title);
+      waitForInput();
+    } else {
+      clearScreen();
+      std::cout << "\n Tidak ada lagu dengan " << label << " " << low
+                << " - " << high << "!\n";
+      waitForInput();
+    }
+    return filtered;
   }
 
+  /**
+   * @brief Membersihkan layar terminal dengan ANSI escape code
+   *
+   */
+  void clearScreen() { screen_.clear(); }
+
   /**
    * @brief Menampilkan border (garis atas dan bawah) serta judul halaman
    *
    * @param title Judul menu yang ingin ditampilkan di tengah
    * @param lines Jumlah baris konten untuk menentukan lokasi garis bawah
    */
-  void printBorder(const std::string& title, int lines) {
+  void printBorder(const Text::Styled& title, int lines) {
     const int width = 61;
     Text::moveCursor(1, 1);
     std::cout << std::setfill('-') << std::setw(width) << '-';
@@ -1779,6 +10258,14 @@ class RAiVFY {
     Text::moveCursor(2, 1);
   }
 
+  /**
+   * @brief Menampilkan border dengan judul tanpa format
+   *
+   */
+  void printBorder(std::string_view title, int lines) {
+    printBorder(Text::Styled{{}, title}, lines);
+  }
+
   /**
    * @brief Menunggu input pengguna untu melanjutkan
    *
@@ -1825,6 +10312,8 @@ class RAiVFY {
   }
 
   void deleteFilePlaylist(int index) {
+    persistence_.cancel(playlist_library.arr[index].filename());
+
     std::string command;
 #ifdef __WIN32__
     command = "delete '" + playlist_library.arr[index].name() + ".dat'";
@@ -1860,10 +10349,11 @@ class RAiVFY {
     std::cout << " 2.  Hapus Lagu\n";
     std::cout << " 3.  Daftar Lagu\n";
     std::cout << " 4.  Hapus Database\n";
+    std::cout << " 5.  Statistik Kinerja\n";
     std::cout << " 0.  Keluar\n\n";
 
     int choice = getNumberInput<int>(" Pilihan Menu : ");
-    enum mainMenu { KELUAR, TAMBAH, HAPUS, DAFTAR, DELETE_ALL };
+    enum mainMenu { KELUAR, TAMBAH, HAPUS, DAFTAR, DELETE_ALL, STATISTIK };
     switch (choice) {
       case KELUAR:
         isAdmin = false;
@@ -1880,18 +10370,79 @@ class RAiVFY {
         daftarLagu();
         break;
       case DELETE_ALL:
-#ifdef __WIN32__
-        system("delete DatabaseLagu.dat");
-#else
-        system("rm DatabaseLagu.dat");
-#endif
-        library.database().clear();
+        library.clear();
+        break;
+      case STATISTIK:
+        statistikKinerja();
         break;
       default:
         std::cout << "Menu tidak tersedia!\n";
     }
   }
 
+  // Menu statistik kinerja Admin
+  void statistikKinerja() {
+    clearScreen();
+    if (!Metrics::kEnabled) {
+      printBorder("Statistik Kinerja", 6);
+      std::cout << "\n Instrumentasi tidak aktif. Build ulang dengan "
+                << Text::bold("-DRAIVFY_METRICS") << ".\n\n";
+      std::cin.ignore();
+      waitForInput();
+      return;
+    }
+
+    Metrics::Report report = Metrics::collect();
+    Frame frame(Metrics::kProbeCount + Metrics::kCounterCount + 10);
+    frame.rule(20).text(Text::bold("Statistik Kinerja")).rule(24).endLine();
+    frame.endLine().rule(61).endLine();
+    frame.boldCell("Probe", 8)
+        .boldCell("Jumlah", 9)
+        .boldCell("Rata2", 11)
+        .boldCell("p50", 11)
+        .boldCell("p99", 11)
+        .boldCell("Maks", 11)
+        .endLine();
+    frame.rule(61).endLine();
+
+    for (size_t i = 0; i < Metrics::kProbeCount; i++) {
+      const Metrics::Summary& summary = report.probes[i];
+      frame.cell(Metrics::probeName(static_cast<Metrics::Probe>(i)), 8)
+          .cell(static_cast<size_t>(summary.count), 9)
+          .cell(Metrics::formatDuration(summary.meanNs()), 11)
+          .cell(Metrics::formatDuration(summary.p50_ns), 11)
+          .cell(Metrics::formatDuration(summary.p99_ns), 11)
+          .cell(Metrics::formatDuration(summary.max_ns), 11)
+          .endLine();
+    }
+    frame.rule(61).endLine();
+
+    for (size_t i = 0; i < Metrics::kCounterCount; i++) {
+      frame.text(" ")
+          .cell(Metrics::counterName(static_cast<Metrics::Counter>(i)), 18)
+          .cell(static_cast<size_t>(report.counters[i]), 20)
+          .endLine();
+    }
+    frame.endLine();
+    screen_.present(std::move(frame));
+
+    std::cout << " 1. Simpan sebagai JSON (" << Text::bold(kMetricsFile)
+              << ")\n 0. Kembali\n";
+    if (getNumberInput<int>(" > Pilihan : ") == 1) {
+      std::ofstream file(kMetricsFile);
+      if (file) {
+        Metrics::writeJson(file);
+        std::cout << " Statistik disimpan ke " << Text::bold(kMetricsFile)
+                  << "\n";
+      } else {
+        std::cerr << "Tidak dapat membuka file: " << Text::bold(kMetricsFile)
+                  << "!\n";
+      }
+      std::cin.ignore();
+      waitForInput();
+    }
+  }
+
   // Menu tambah  lagu Admin
   void tambahLaguByAdmin() {
     clearScreen();
@@ -1917,8 +10468,11 @@ class RAiVFY {
 
     diputar = getNumberInput<int>(Text::bold(" Play Count\t: "));
 
-    library.addToLibrary(Song(judul, artis, genre, tahun, durasi, diputar));
-    FileManager::save(FileManager::kDatabase, library.database());
+    if (!library.addToLibrary(
+            Song(judul, artis, genre, tahun, durasi, diputar))) {
+      std::cout << "\nLagu gagal ditambahkan ke database!\n";
+      return;
+    }
 
     std::cout << "\nLagu berhasil ditambahkan ke database!\n";
   }
@@ -1926,34 +10480,60 @@ class RAiVFY {
   // Menu hapus lagu Admin
   void hapusLagubyAdmin() {
     clearScreen();
-    printBorder("Hapus Lagu", library.database().size() + 8);
-    if (library.database().empty()) {
+    printBorder("Hapus Lagu", library.size() + 8);
+    if (library.size() == 0) {
       std::cout << "Database masih kosong!\n";
       std::cin.ignore();
       waitForInput();
       return;
     }
 
-    tabelLagu(library.database());
+    tabelLagu(library.view());
     size_t idLagu =
         getNumberInput<size_t>("\nMasukkan ID lagu yang ingin dihapus: ");
 
     library.removeSongById(idLagu);
 
     Song::id_counter = 1;
-
-    FileManager::save(FileManager::kDatabase, library.database());
-    FileManager::load(FileManager::kDatabase, library.database());
+    library.reindex();
 
     std::cout << "\nLagu Berhasil Di Hapus!\n";
   }
 };
 #pragma endregion
 
-int main() {
+// Didefinisikan oleh program lain yang memakai sumber ini (misalnya bench.cpp)
+#ifndef RAIVFY_NO_MAIN
+int main(int argc, char* argv[]) {
   RAiVFY app;
+
+  if (argc > 1) {
+    std::string mode = argv[1];
+    if (mode == "-h" || mode == "--help") {
+      RAiVFY::printUsage(std::cout);
+      return 0;
+    }
+
+    app.load();
+    if (mode == "--batch") {
+      if (argc < 3 || std::string(argv[2]) == "-") {
+        return app.runBatch(std::cin);
+      }
+
+      std::ifstream commands(argv[2]);
+      if (!commands) {
+        std::cerr << "Tidak dapat membuka file: " << argv[2] << "\n";
+        return 1;
+      }
+      return app.runBatch(commands);
+    }
+
+    return app.runCommand(std::vector<std::string>(argv + 1, argv + argc));
+  }
+
   app.load();
   app.ignite();
 
   return 0;
-}
\ No newline at end of file
+}
+#endif  // RAIVFY_NO_MAIN
\ No newline at end of file